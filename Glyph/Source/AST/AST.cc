@@ -16,7 +16,8 @@ namespace Glyph
 				   {"<", OperatorNode::Operator::Less},		  {">", OperatorNode::Operator::Greater},
 				   {"==", OperatorNode::Operator::Equal},	  {"!=", OperatorNode::Operator::NotEqual},
 				   {"<=", OperatorNode::Operator::LessEqual}, {">=", OperatorNode::Operator::GreaterEqual},
-				   {"=", OperatorNode::Operator::Assign}};
+				   {"&&", OperatorNode::Operator::And},		  {"||", OperatorNode::Operator::Or},
+				   {"in", OperatorNode::Operator::In},		  {"=", OperatorNode::Operator::Assign}};
 			return operatorMap[op];
 		}
 	} // namespace
@@ -213,8 +214,60 @@ namespace Glyph
 	{
 	}
 
+	LiteralNode::LiteralNode(std::string value)
+		: ExpressionNode(NodeType::LiteralNode)
+		, m_string(std::move(value))
+	{
+	}
+
 	Value LiteralNode::GetValue() const { return m_value; }
 
+	ArrayLiteralNode::ArrayLiteralNode(const std::vector<ExpressionNodePtr>& elements)
+		: ExpressionNode(NodeType::ArrayLiteralNode)
+		, m_elements(elements)
+	{
+	}
+
+	const std::vector<ExpressionNodePtr>& ArrayLiteralNode::GetElements() const { return m_elements; }
+
+	DictLiteralNode::DictLiteralNode(const std::vector<Entry>& entries)
+		: ExpressionNode(NodeType::DictLiteralNode)
+		, m_entries(entries)
+	{
+	}
+
+	const std::vector<DictLiteralNode::Entry>& DictLiteralNode::GetEntries() const { return m_entries; }
+
+	RecordLiteralNode::RecordLiteralNode(const std::vector<Field>& fields)
+		: ExpressionNode(NodeType::RecordLiteralNode)
+		, m_fields(fields)
+	{
+	}
+
+	const std::vector<RecordLiteralNode::Field>& RecordLiteralNode::GetFields() const { return m_fields; }
+
+	IndexExpressionNode::IndexExpressionNode(ExpressionNodePtr object, ExpressionNodePtr key)
+		: ExpressionNode(NodeType::IndexExpressionNode)
+		, m_object(std::move(object))
+		, m_key(std::move(key))
+	{
+	}
+
+	const ExpressionNodePtr& IndexExpressionNode::GetObject() const { return m_object; }
+
+	const ExpressionNodePtr& IndexExpressionNode::GetKey() const { return m_key; }
+
+	FieldExpressionNode::FieldExpressionNode(ExpressionNodePtr object, std::string name)
+		: ExpressionNode(NodeType::FieldExpressionNode)
+		, m_object(std::move(object))
+		, m_name(std::move(name))
+	{
+	}
+
+	const ExpressionNodePtr& FieldExpressionNode::GetObject() const { return m_object; }
+
+	const std::string& FieldExpressionNode::GetName() const { return m_name; }
+
 	OperatorNode::OperatorNode(Operator op)
 		: AstNode(NodeType::OperatorNode)
 		, m_op(op)
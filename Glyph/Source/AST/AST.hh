@@ -3,7 +3,9 @@
 #include <Runtime/Value.hh>
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -27,6 +29,11 @@ namespace Glyph
 	V(LambdaExpressionNode)                                                                                            \
 	V(IdentifierNode)                                                                                                  \
 	V(LiteralNode)                                                                                                     \
+	V(ArrayLiteralNode)                                                                                                \
+	V(DictLiteralNode)                                                                                                 \
+	V(RecordLiteralNode)                                                                                               \
+	V(IndexExpressionNode)                                                                                             \
+	V(FieldExpressionNode)                                                                                             \
 	V(OperatorNode)                                                                                                    \
 	V(ArgumentListNode)                                                                                                \
 	V(ReturnStatementNode)
@@ -254,11 +261,85 @@ namespace Glyph
 	  public:
 		explicit LiteralNode(double value);
 		explicit LiteralNode(bool value);
+		explicit LiteralNode(std::string value);
 
+		/// @brief Null for a string literal, strings only become values once the compiler interns them.
 		Value GetValue() const;
 
+		[[nodiscard]] bool IsString() const { return m_string.has_value(); }
+		[[nodiscard]] const std::string& GetString() const { return *m_string; }
+
 	  private:
 		Value m_value;
+		std::optional<std::string> m_string;
+	};
+
+	class ArrayLiteralNode : public ExpressionNode
+	{
+	  public:
+		explicit ArrayLiteralNode(const std::vector<ExpressionNodePtr>& elements);
+
+		[[nodiscard]] const std::vector<ExpressionNodePtr>& GetElements() const;
+
+	  private:
+		std::vector<ExpressionNodePtr> m_elements;
+	};
+
+	class DictLiteralNode : public ExpressionNode
+	{
+	  public:
+		using Entry = std::pair<ExpressionNodePtr, ExpressionNodePtr>;
+
+	  public:
+		explicit DictLiteralNode(const std::vector<Entry>& entries);
+
+		[[nodiscard]] const std::vector<Entry>& GetEntries() const;
+
+	  private:
+		std::vector<Entry> m_entries;
+	};
+
+	/// @brief object[key], also the target of an assignment when it is the lhs of '='.
+	class IndexExpressionNode : public ExpressionNode
+	{
+	  public:
+		IndexExpressionNode(ExpressionNodePtr object, ExpressionNodePtr key);
+
+		[[nodiscard]] const ExpressionNodePtr& GetObject() const;
+		[[nodiscard]] const ExpressionNodePtr& GetKey() const;
+
+	  private:
+		ExpressionNodePtr m_object;
+		ExpressionNodePtr m_key;
+	};
+
+	/// @brief {name: value, ...}, the fields in the order they are written. Records with the same order share a shape.
+	class RecordLiteralNode : public ExpressionNode
+	{
+	  public:
+		using Field = std::pair<std::string, ExpressionNodePtr>;
+
+	  public:
+		explicit RecordLiteralNode(const std::vector<Field>& fields);
+
+		[[nodiscard]] const std::vector<Field>& GetFields() const;
+
+	  private:
+		std::vector<Field> m_fields;
+	};
+
+	/// @brief object.name, also the target of an assignment when it is the lhs of '='.
+	class FieldExpressionNode : public ExpressionNode
+	{
+	  public:
+		FieldExpressionNode(ExpressionNodePtr object, std::string name);
+
+		[[nodiscard]] const ExpressionNodePtr& GetObject() const;
+		[[nodiscard]] const std::string& GetName() const;
+
+	  private:
+		ExpressionNodePtr m_object;
+		std::string m_name;
 	};
 
 	class OperatorNode : public AstNode
@@ -276,6 +357,9 @@ namespace Glyph
 			NotEqual,
 			LessEqual,
 			GreaterEqual,
+			And,
+			Or,
+			In,
 			Assign
 		};
 
@@ -1,10 +1,132 @@
 #include "BytecodeChunk.hh"
+#include <Runtime/FunctionObject.hh>
+
+#include <iomanip>
 
 namespace Glyph::Bytecode
 {
-	void BytecodeChunk::Grow(size_t size)
+	BytecodeChunk::BytecodeChunk(std::unique_ptr<const Instruction[]> bytecode, size_t count,
+								 ConstantTable constantTable, uint32_t localCount, uint32_t globalCount,
+								 std::vector<std::unique_ptr<FunctionObject>> functions,
+								 std::vector<JumpTable> jumpTables, std::vector<SortedJumpTable> sortedJumpTables,
+								 std::vector<OwnedString> strings, std::vector<RecordLayout> recordLayouts,
+								 std::vector<FieldCache> fieldCaches)
+		: m_ConstantTable(std::move(constantTable))
+		, m_Bytecode(std::move(bytecode))
+		, m_InstructionCount(count)
+		, m_LocalCount(localCount)
+		, m_GlobalCount(globalCount)
+		, m_Functions(std::move(functions))
+		, m_JumpTables(std::move(jumpTables))
+		, m_SortedJumpTables(std::move(sortedJumpTables))
+		, m_Strings(std::move(strings))
+		, m_RecordLayouts(std::move(recordLayouts))
+		, m_FieldCaches(std::move(fieldCaches))
+	{
+	}
+
+	BytecodeChunk::~BytecodeChunk() = default;
+	BytecodeChunk::BytecodeChunk(BytecodeChunk&&) noexcept = default;
+	BytecodeChunk& BytecodeChunk::operator=(BytecodeChunk&&) noexcept = default;
+
+	void BytecodeChunk::ClearCaches() const
 	{
-		m_Bytecode.reserve(m_Bytecode.size() + size);
-		m_Bytecode.resize(m_Bytecode.size() + size);
+		for(auto& layout : m_RecordLayouts)
+		{
+			layout.CachedShape = nullptr;
+		}
+
+		for(auto& cache : m_FieldCaches)
+		{
+			cache = FieldCache {.Name = std::move(cache.Name)};
+		}
+
+		for(const auto& function : m_Functions)
+		{
+			function->GetChunk().ClearCaches();
+		}
+	}
+
+	void BytecodeChunk::Disassemble(std::ostream& out) const
+	{
+		uint32_t wide = 0;
+		for(size_t i = 0; i < m_InstructionCount; i++)
+		{
+			auto& instruction = m_Bytecode[i];
+			if(instruction.IsType(Opcode::WIDE))
+			{
+				wide = instruction.GetOperand();
+				continue;
+			}
+
+			auto operand = (wide << Instruction::OperandBits) | instruction.GetOperand();
+			wide = 0;
+
+			out << std::setw(6) << i << "  " << Instruction::ToString(instruction.GetType(), operand);
+			if(instruction.IsType(Opcode::LOAD_CONST))
+			{
+				if(auto value = m_ConstantTable.GetValue(operand); value.ok())
+				{
+					out << "  ; " << (*value)->ToString();
+				}
+			}
+			else if((instruction.IsType(Opcode::GET_FIELD) || instruction.IsType(Opcode::SET_FIELD))
+					&& operand < m_FieldCaches.size())
+			{
+				out << "  ; ." << m_FieldCaches[operand].Name;
+			}
+			out << std::endl;
+		}
+
+		for(size_t i = 0; i < m_JumpTables.size(); i++)
+		{
+			auto& table = m_JumpTables[i];
+			out << "jump table " << i << ": low " << table.Low << ", default " << table.Default << ", targets";
+			for(auto target : table.Targets)
+			{
+				out << " " << target;
+			}
+			out << std::endl;
+		}
+
+		for(size_t i = 0; i < m_SortedJumpTables.size(); i++)
+		{
+			auto& table = m_SortedJumpTables[i];
+			out << "sorted jump table " << i << ": default " << table.Default;
+			for(size_t key = 0; key < table.Keys.size(); key++)
+			{
+				out << " " << table.Keys[key] << "->" << table.Targets[key];
+			}
+			out << std::endl;
+		}
+
+		for(size_t i = 0; i < m_RecordLayouts.size(); i++)
+		{
+			out << "record layout " << i << ":";
+			for(const auto& field : m_RecordLayouts[i].Fields)
+			{
+				out << " " << field;
+			}
+			out << std::endl;
+		}
+
+		for(size_t i = 0; i < m_FieldCaches.size(); i++)
+		{
+			out << "field cache " << i << ": " << m_FieldCaches[i].Name << std::endl;
+		}
+
+		for(const auto& function : m_Functions)
+		{
+			out << std::endl << function->ToString() << " (arity " << function->GetArity() << ")" << std::endl;
+			for(const auto& upvalue : function->GetUpvalues())
+			{
+				out << "  upvalue " << (upvalue.IsLocal ? "local " : "upvalue ") << upvalue.Index << std::endl;
+			}
+			if(function->GetCallerLocalCount() != 0)
+			{
+				out << "  borrows " << function->GetCallerLocalCount() << " caller locals" << std::endl;
+			}
+			function->GetChunk().Disassemble(out);
+		}
 	}
 } // namespace Glyph::Bytecode
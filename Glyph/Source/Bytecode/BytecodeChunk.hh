@@ -2,24 +2,121 @@
 
 #include <Bytecode/BytecodeInstruction.hh>
 #include <Runtime/ConstantTable.hh>
+#include <Runtime/StringObject.hh>
+
+#include <array>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
 #include <vector>
 
+namespace Glyph
+{
+	class FunctionObject;
+	class Shape;
+}
+
 namespace Glyph::Bytecode
 {
+	/// @brief Side table of SWITCH_TABLE, an integral key Low + i jumps to Targets[i], anything else to Default.
+	struct JumpTable
+	{
+		double Low;
+		std::vector<uint32_t> Targets;
+		uint32_t Default;
+	};
+
+	/// @brief Side table of SWITCH_SORTED for keys too sparse for a JumpTable, binary searched at runtime.
+	struct SortedJumpTable
+	{
+		std::vector<double> Keys;
+		std::vector<uint32_t> Targets;
+		uint32_t Default;
+	};
+
+	/// @brief Side table of RECORD_NEW, the field names in the order the literal lists them.
+	struct RecordLayout
+	{
+		std::vector<std::string> Fields;
+		/// @brief Shape of the records the literal builds, looked up by the VM the first time it runs.
+		const Shape* CachedShape {nullptr};
+	};
+
+	/// @brief Inline cache of a single GET_FIELD or SET_FIELD: the slot of Name in the last shapes seen there, tried in
+	/// order before falling back to Shape::Find. A site seeing one shape stays monomorphic, up to MaxEntries make it
+	/// polymorphic. Past that it is megamorphic and searches every time rather than thrashing the entries.
+	struct FieldCache
+	{
+		static constexpr uint32_t MaxEntries = 4;
+
+		std::string Name;
+		std::array<const Shape*, MaxEntries> Shapes {};
+		std::array<uint32_t, MaxEntries> Slots {};
+		uint32_t EntryCount {0};
+		bool Megamorphic {false};
+	};
+
+	/// @brief Immutable, exactly sized bytecode and its constants. Built by BytecodeChunkBuilder. Only the caches of
+	/// its record literals and field accesses change while it runs.
 	class BytecodeChunk
 	{
 	  public:
 		BytecodeChunk() = default;
-		~BytecodeChunk() = default;
+		BytecodeChunk(std::unique_ptr<const Instruction[]> bytecode, size_t count, ConstantTable constantTable,
+					  uint32_t localCount, uint32_t globalCount,
+					  std::vector<std::unique_ptr<FunctionObject>> functions = {},
+					  std::vector<JumpTable> jumpTables = {}, std::vector<SortedJumpTable> sortedJumpTables = {},
+					  std::vector<OwnedString> strings = {}, std::vector<RecordLayout> recordLayouts = {},
+					  std::vector<FieldCache> fieldCaches = {});
+		~BytecodeChunk();
 
-		ConstantTable& GetConstantTable() { return m_ConstantTable; }
-		[[nodiscard]] uint8_t* Bytecode() { return m_Bytecode.data(); }
-		[[nodiscard]] size_t BytecodeSize() const { return m_Bytecode.size(); }
-		void Grow(size_t size);
+		BytecodeChunk(BytecodeChunk&&) noexcept;
+		BytecodeChunk& operator=(BytecodeChunk&&) noexcept;
+
+		[[nodiscard]] const ConstantTable& GetConstantTable() const { return m_ConstantTable; }
+		[[nodiscard]] const Instruction* Bytecode() const { return m_Bytecode.get(); }
+		[[nodiscard]] size_t InstructionCount() const { return m_InstructionCount; }
+		[[nodiscard]] size_t BytecodeSize() const { return m_InstructionCount * sizeof(Instruction); }
+		/// @brief Number of local slots the frame running this chunk reserves above its base.
+		[[nodiscard]] uint32_t LocalCount() const { return m_LocalCount; }
+		/// @brief Number of globals the chunk may refer to.
+		[[nodiscard]] uint32_t GlobalCount() const { return m_GlobalCount; }
+		/// @brief Functions declared directly inside this chunk, referenced from its constant table.
+		[[nodiscard]] const std::vector<std::unique_ptr<FunctionObject>>& Functions() const { return m_Functions; }
+		/// @brief String literals interned while compiling this chunk, referenced from its constant table or from the
+		/// ones of its nested functions.
+		[[nodiscard]] const std::vector<OwnedString>& Strings() const { return m_Strings; }
+		[[nodiscard]] const std::vector<JumpTable>& JumpTables() const { return m_JumpTables; }
+		[[nodiscard]] const std::vector<SortedJumpTable>& SortedJumpTables() const { return m_SortedJumpTables; }
+		[[nodiscard]] std::span<RecordLayout> RecordLayouts() const { return m_RecordLayouts; }
+		[[nodiscard]] std::span<FieldCache> FieldCaches() const { return m_FieldCaches; }
+
+		/// @brief Forgets the shapes cached by this chunk and its nested functions. Shapes belong to the VM that
+		/// created them, a chunk starting on a VM must not keep the ones of another.
+		void ClearCaches() const;
+
+		/// @brief Set once BytecodeVerifier accepted the chunk, the VM refuses to run it before that.
+		[[nodiscard]] bool IsVerified() const { return m_Verified; }
+
+		/// @brief Prints the bytecode followed by every nested function.
+		void Disassemble(std::ostream& out) const;
 
 	  private:
+		friend class BytecodeVerifier;
+
 		ConstantTable m_ConstantTable;
-		std::vector<uint8_t> m_Bytecode;
+		std::unique_ptr<const Instruction[]> m_Bytecode;
+		size_t m_InstructionCount {0};
+		uint32_t m_LocalCount {0};
+		uint32_t m_GlobalCount {0};
+		std::vector<std::unique_ptr<FunctionObject>> m_Functions;
+		std::vector<JumpTable> m_JumpTables;
+		std::vector<SortedJumpTable> m_SortedJumpTables;
+		std::vector<OwnedString> m_Strings;
+		mutable std::vector<RecordLayout> m_RecordLayouts;
+		mutable std::vector<FieldCache> m_FieldCaches;
+		bool m_Verified {false};
 	};
 
 } // namespace Glyph::Bytecode
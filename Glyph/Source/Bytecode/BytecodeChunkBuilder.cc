@@ -0,0 +1,105 @@
+#include <Bytecode/BytecodeChunkBuilder.hh>
+#include <Runtime/FunctionObject.hh>
+
+#include <algorithm>
+
+namespace Glyph::Bytecode
+{
+	BytecodeChunkBuilder::BytecodeChunkBuilder() = default;
+	BytecodeChunkBuilder::~BytecodeChunkBuilder() = default;
+	BytecodeChunkBuilder::BytecodeChunkBuilder(BytecodeChunkBuilder&&) noexcept = default;
+	BytecodeChunkBuilder& BytecodeChunkBuilder::operator=(BytecodeChunkBuilder&&) noexcept = default;
+
+	void BytecodeChunkBuilder::Reserve(size_t count)
+	{
+		if(count > m_Capacity)
+		{
+			Reallocate(count);
+		}
+	}
+
+	Instruction* BytecodeChunkBuilder::Grow(size_t count)
+	{
+		if(m_Size + count > m_Capacity) [[unlikely]]
+		{
+			Reallocate(std::max({m_Capacity * 2, m_Size + count, InitialCapacity}));
+		}
+
+		auto* start = m_Bytecode.get() + m_Size;
+		m_Size += count;
+
+		return start;
+	}
+
+	FunctionObject* BytecodeChunkBuilder::AddFunction(std::unique_ptr<FunctionObject> function)
+	{
+		return m_Functions.emplace_back(std::move(function)).get();
+	}
+
+	StringObject* BytecodeChunkBuilder::AddString(OwnedString string)
+	{
+		return m_Strings.emplace_back(std::move(string)).get();
+	}
+
+	uint32_t BytecodeChunkBuilder::AddJumpTable(JumpTable table)
+	{
+		m_JumpTables.push_back(std::move(table));
+
+		return m_JumpTables.size() - 1;
+	}
+
+	uint32_t BytecodeChunkBuilder::AddSortedJumpTable(SortedJumpTable table)
+	{
+		m_SortedJumpTables.push_back(std::move(table));
+
+		return m_SortedJumpTables.size() - 1;
+	}
+
+	uint32_t BytecodeChunkBuilder::AddRecordLayout(std::vector<std::string> fields)
+	{
+		m_RecordLayouts.push_back({std::move(fields)});
+
+		return m_RecordLayouts.size() - 1;
+	}
+
+	uint32_t BytecodeChunkBuilder::AddFieldCache(std::string name)
+	{
+		m_FieldCaches.push_back({std::move(name)});
+
+		return m_FieldCaches.size() - 1;
+	}
+
+	BytecodeChunk BytecodeChunkBuilder::Seal()
+	{
+		auto bytecode = std::make_unique<Instruction[]>(m_Size);
+		std::copy_n(m_Bytecode.get(), m_Size, bytecode.get());
+
+		BytecodeChunk chunk(std::move(bytecode), m_Size, std::move(m_ConstantTable), m_LocalCount, m_GlobalCount,
+							std::move(m_Functions), std::move(m_JumpTables), std::move(m_SortedJumpTables),
+							std::move(m_Strings), std::move(m_RecordLayouts), std::move(m_FieldCaches));
+
+		m_ConstantTable = ConstantTable();
+		m_Bytecode.reset();
+		m_Size = 0;
+		m_Capacity = 0;
+		m_LocalCount = 0;
+		m_GlobalCount = 0;
+		m_Functions.clear();
+		m_JumpTables.clear();
+		m_SortedJumpTables.clear();
+		m_Strings.clear();
+		m_RecordLayouts.clear();
+		m_FieldCaches.clear();
+
+		return chunk;
+	}
+
+	void BytecodeChunkBuilder::Reallocate(size_t capacity)
+	{
+		auto bytecode = std::make_unique<Instruction[]>(capacity);
+		std::copy_n(m_Bytecode.get(), m_Size, bytecode.get());
+
+		m_Bytecode = std::move(bytecode);
+		m_Capacity = capacity;
+	}
+} // namespace Glyph::Bytecode
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Bytecode/BytecodeChunk.hh>
+#include <Bytecode/BytecodeInstruction.hh>
+#include <Runtime/ConstantTable.hh>
+#include <Runtime/StringObject.hh>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Glyph::Bytecode
+{
+	/// @brief Growable bytecode buffer used while compiling, sealed into an immutable BytecodeChunk at the end.
+	class BytecodeChunkBuilder
+	{
+	  public:
+		static constexpr size_t InitialCapacity = 64;
+
+	  public:
+		BytecodeChunkBuilder();
+		~BytecodeChunkBuilder();
+
+		BytecodeChunkBuilder(const BytecodeChunkBuilder&) = delete;
+		BytecodeChunkBuilder& operator=(const BytecodeChunkBuilder&) = delete;
+		BytecodeChunkBuilder(BytecodeChunkBuilder&&) noexcept;
+		BytecodeChunkBuilder& operator=(BytecodeChunkBuilder&&) noexcept;
+
+		ConstantTable& GetConstantTable() { return m_ConstantTable; }
+		[[nodiscard]] Instruction* Bytecode() { return m_Bytecode.get(); }
+		[[nodiscard]] size_t InstructionCount() const { return m_Size; }
+		[[nodiscard]] size_t Capacity() const { return m_Capacity; }
+
+		void SetLocalCount(uint32_t count) { m_LocalCount = count; }
+		void SetGlobalCount(uint32_t count) { m_GlobalCount = count; }
+
+		/// @brief Takes ownership of a function compiled inside this chunk, it moves into the sealed chunk.
+		FunctionObject* AddFunction(std::unique_ptr<FunctionObject> function);
+		/// @brief Takes ownership of a string literal, it moves into the sealed chunk.
+		StringObject* AddString(OwnedString string);
+
+		/// @brief Adds a side table for SWITCH_TABLE / SWITCH_SORTED and returns its index, the operand.
+		uint32_t AddJumpTable(JumpTable table);
+		uint32_t AddSortedJumpTable(SortedJumpTable table);
+		JumpTable& GetJumpTable(uint32_t index) { return m_JumpTables[index]; }
+
+		/// @brief Adds the layout of a record literal and returns its index, the operand of RECORD_NEW.
+		uint32_t AddRecordLayout(std::vector<std::string> fields);
+		/// @brief Adds an empty inline cache for one field access and returns its index, the operand of GET_FIELD or
+		/// SET_FIELD. Every access gets its own, shared caches would mix the shapes of unrelated sites.
+		uint32_t AddFieldCache(std::string name);
+		SortedJumpTable& GetSortedJumpTable(uint32_t index) { return m_SortedJumpTables[index]; }
+
+		/// @brief Makes room for at least count instructions in total, e.g. from a size estimate of the AST.
+		void Reserve(size_t count);
+
+		/// @brief Appends count default instructions and returns a pointer to the first one.
+		/// Capacity grows geometrically so emitting N instructions costs O(N) copies overall.
+		Instruction* Grow(size_t count);
+
+		/// @brief Moves the constants and copies the bytecode into an exactly sized chunk, leaving the builder empty.
+		BytecodeChunk Seal();
+
+	  private:
+		void Reallocate(size_t capacity);
+
+	  private:
+		ConstantTable m_ConstantTable;
+		std::unique_ptr<Instruction[]> m_Bytecode;
+		size_t m_Size {0};
+		size_t m_Capacity {0};
+		uint32_t m_LocalCount {0};
+		uint32_t m_GlobalCount {0};
+		std::vector<std::unique_ptr<FunctionObject>> m_Functions;
+		std::vector<JumpTable> m_JumpTables;
+		std::vector<SortedJumpTable> m_SortedJumpTables;
+		std::vector<OwnedString> m_Strings;
+		std::vector<RecordLayout> m_RecordLayouts;
+		std::vector<FieldCache> m_FieldCaches;
+	};
+} // namespace Glyph::Bytecode
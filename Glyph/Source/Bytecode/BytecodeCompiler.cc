@@ -1,9 +1,94 @@
 #include "BytecodeInstruction.hh"
 #include <Bytecode/BytecodeCompiler.hh>
+#include <Runtime/FunctionObject.hh>
+
+#include <limits>
+
 namespace Glyph::Bytecode
 {
+	BytecodeCompiler::BytecodeCompiler() { m_Builders.emplace_back(); }
+
+	absl::Status BytecodeCompiler::EmitInstruction(Opcode type, uint64_t operand)
+	{
+		if(operand > std::numeric_limits<uint32_t>::max())
+		{
+			return absl::OutOfRangeError("BytecodeCompiler::EmitInstruction: Operand does not fit in 32 bits");
+		}
+
+		bool wide = operand > Instruction::MaxOperand;
+
+		auto* instructionArena = CurrentBuilder().Grow(wide ? 2 : 1);
+
+		if(wide)
+		{
+			*instructionArena++ = Instruction(Opcode::WIDE, operand >> Instruction::OperandBits);
+		}
+
+		*instructionArena = Instruction(type, operand & Instruction::MaxOperand);
+
+		return absl::OkStatus();
+	}
+
 	ConstantTableIndex BytecodeCompiler::MakeConstant(const Glyph::Value& value)
 	{
-		return m_Chunk.GetConstantTable().AddValue(value);
+		return CurrentBuilder().GetConstantTable().AddValue(value);
+	}
+
+	absl::StatusOr<uint32_t> BytecodeCompiler::EmitForwardJump(Opcode type)
+	{
+		auto position = CurrentOffset();
+
+		if(auto status = EmitInstruction(type, 0); !status.ok())
+		{
+			return status;
+		}
+
+		return position;
+	}
+
+	absl::Status BytecodeCompiler::PatchJump(uint32_t position)
+	{
+		auto target = CurrentOffset();
+
+		// The placeholder was emitted without a WIDE prefix, so the target has to fit a single word.
+		if(target > Instruction::MaxOperand)
+		{
+			return absl::OutOfRangeError("BytecodeCompiler::PatchJump: Jump target does not fit in 24 bits");
+		}
+
+		auto& instruction = CurrentBuilder().Bytecode()[position];
+		instruction = Instruction(instruction.GetType(), target);
+
+		return absl::OkStatus();
+	}
+
+	StringObject* BytecodeCompiler::InternString(std::string_view chars)
+	{
+		auto hash = StringObject::Hash(chars);
+		if(auto* string = m_Strings.Find(chars, hash))
+		{
+			return string;
+		}
+
+		// Owned by the chunk seeing it first. Chunks of nested functions are owned by their parent chunk, so the
+		// string lives as long as any chunk referencing it.
+		auto* string = CurrentBuilder().AddString(StringObject::CreatePermanent(chars));
+		m_Strings.Add(string);
+
+		return string;
+	}
+
+	void BytecodeCompiler::BeginFunction() { m_Builders.emplace_back(); }
+
+	ConstantTableIndex BytecodeCompiler::EndFunction(std::string name, uint32_t arity,
+													 std::vector<UpvalueDescriptor> upvalues, uint32_t callerLocalCount)
+	{
+		auto function = std::make_unique<FunctionObject>(std::move(name), arity, CurrentBuilder().Seal(),
+														 std::move(upvalues), callerLocalCount);
+		m_Builders.pop_back();
+
+		auto* object = CurrentBuilder().AddFunction(std::move(function));
+
+		return MakeConstant(Value(object));
 	}
 } // namespace Glyph::Bytecode
@@ -1,31 +1,68 @@
 #pragma once
 
 #include <Bytecode/BytecodeChunk.hh>
+#include <Bytecode/BytecodeChunkBuilder.hh>
 #include <Bytecode/BytecodeInstruction.hh>
 #include <Runtime/ConstantTable.hh>
+#include <Runtime/FunctionObject.hh>
+#include <Runtime/StringTable.hh>
 
 #include <absl/status/status.h>
+#include <absl/status/statusor.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace Glyph::Bytecode
 {
 	class BytecodeCompiler
 	{
 	  public:
+		BytecodeCompiler();
+
 		template<typename TInstruction, typename... Args> absl::Status Emit(Args&&... args)
 		{
-			auto instrStart = m_Chunk.BytecodeSize();
-			auto instructionSize = sizeof(TInstruction);
-			m_Chunk.Grow(instructionSize);
-			auto* instructionArena = m_Chunk.Bytecode() + instrStart;
-
-			new(instructionArena) TInstruction(std::forward<Args>(args)...);
-
-			return absl::OkStatus();
+			return EmitInstruction(TInstruction::Type, static_cast<uint64_t>(std::forward<Args>(args))...);
 		}
 
+		/// @brief Appends a single instruction word, prefixed by WIDE when the operand needs more than 24 bits.
+		absl::Status EmitInstruction(Opcode type, uint64_t operand = 0);
+
 		ConstantTableIndex MakeConstant(const Value& value);
 
-	  public:
-		BytecodeChunk m_Chunk; // FIXME: Multiple chunks(frames) per functions and scopes. One for now.
+		/// @brief The literal with these characters, created in the current chunk the first time it is seen. Every
+		/// function of the program shares one object per literal.
+		StringObject* InternString(std::string_view chars);
+
+		/// @brief Index the next emitted instruction will have, what a jump to it uses as target.
+		[[nodiscard]] uint32_t CurrentOffset() { return CurrentBuilder().InstructionCount(); }
+
+		/// @brief Emits a jump whose target is not known yet, returns its position for PatchJump.
+		absl::StatusOr<uint32_t> EmitForwardJump(Opcode type);
+
+		/// @brief Points a jump emitted by EmitForwardJump at the current offset.
+		absl::Status PatchJump(uint32_t position);
+
+		/// @brief Preallocates room for an expected number of instructions, see BytecodeSizeEstimator.
+		void Reserve(size_t instructionCount) { CurrentBuilder().Reserve(instructionCount); }
+
+		/// @brief The chunk instructions are currently emitted into, the innermost function being compiled.
+		BytecodeChunkBuilder& CurrentBuilder() { return m_Builders.back(); }
+
+		/// @brief Starts emitting into a fresh chunk for the body of a function.
+		void BeginFunction();
+
+		/// @brief Seals the current function body, hands the function to the enclosing chunk and returns its constant.
+		ConstantTableIndex EndFunction(std::string name, uint32_t arity, std::vector<UpvalueDescriptor> upvalues,
+									   uint32_t callerLocalCount = 0);
+
+		/// @brief Finishes compilation and returns the immutable chunk.
+		BytecodeChunk Seal() { return CurrentBuilder().Seal(); }
+
+	  private:
+		// The bottom builder is the program itself, every function being compiled pushes one on top.
+		std::vector<BytecodeChunkBuilder> m_Builders;
+		StringTable m_Strings;
 	};
 } // namespace Glyph::Bytecode
@@ -1,6 +1,10 @@
 #include <Bytecode/BytecodeCompilerVisitor.hh>
 #include <Macros.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 namespace Glyph::Bytecode
 {
 #define N()                                                                                                            \
@@ -17,6 +21,514 @@ namespace Glyph::Bytecode
 	{
 	}
 
+	BytecodeStepResult BytecodeCompilerVisitor::EmitLoad(BytecodeCompiler& compiler, const AstNode& node)
+	{
+		auto* slot = m_Resolution.Find(node);
+		if(!slot)
+		{
+			return BytecodeStepResult(&node, absl::InternalError("Variable was not resolved"));
+		}
+
+		switch(slot->Kind)
+		{
+			case VariableSlot::Kind::Local: TRY(compiler.Emit<LoadLocalInstruction>(slot->Index)); break;
+			case VariableSlot::Kind::Upvalue:
+				// A function borrowing its caller's frame finds every captured variable right in that frame.
+				if(m_Function && m_Escapes.BorrowsCallerFrame(*m_Function))
+				{
+					auto& upvalue = m_Resolution.GetUpvalues(*m_Function)[slot->Index];
+					TRY(compiler.Emit<LoadCallerLocalInstruction>(upvalue.Index));
+				}
+				else
+				{
+					TRY(compiler.Emit<LoadUpvalueInstruction>(slot->Index));
+				}
+				break;
+			case VariableSlot::Kind::Global: TRY(compiler.Emit<LoadGlobalInstruction>(slot->Index)); break;
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitStore(BytecodeCompiler& compiler, const AstNode& node)
+	{
+		auto* slot = m_Resolution.Find(node);
+		if(!slot)
+		{
+			return BytecodeStepResult(&node, absl::InternalError("Variable was not resolved"));
+		}
+
+		switch(slot->Kind)
+		{
+			case VariableSlot::Kind::Local: TRY(compiler.Emit<StoreLocalInstruction>(slot->Index)); break;
+			case VariableSlot::Kind::Upvalue:
+				if(m_Function && m_Escapes.BorrowsCallerFrame(*m_Function))
+				{
+					auto& upvalue = m_Resolution.GetUpvalues(*m_Function)[slot->Index];
+					TRY(compiler.Emit<StoreCallerLocalInstruction>(upvalue.Index));
+				}
+				else
+				{
+					TRY(compiler.Emit<StoreUpvalueInstruction>(slot->Index));
+				}
+				break;
+			case VariableSlot::Kind::Global: TRY(compiler.Emit<StoreGlobalInstruction>(slot->Index)); break;
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitConstant(BytecodeCompiler& compiler, const Value& value)
+	{
+		if(value.IsNull())
+		{
+			TRY(compiler.Emit<LoadNullInstruction>());
+
+			return {};
+		}
+
+		auto constant = compiler.MakeConstant(value);
+
+		TRY(compiler.Emit<LoadConstInstruction>(constant));
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitCall(BytecodeCompiler& compiler, FunctionCallNode& node, bool tail)
+	{
+		// The callee sits right below its arguments, which become the first locals of the new frame.
+		TRY(EmitLoad(compiler, *node.GetName()));
+
+		for(auto& arg : node.GetArgs())
+		{
+			TRY(Visit(compiler, *arg));
+		}
+
+		if(tail && !m_Escapes.CallsFrameFunction(node))
+		{
+			TRY(compiler.Emit<TailCallInstruction>(node.GetArgs().size()));
+		}
+		else
+		{
+			TRY(compiler.Emit<CallInstruction>(node.GetArgs().size()));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitTailExpression(BytecodeCompiler& compiler, ExpressionNode& node)
+	{
+		// Tail position carries into whatever produces the value, never into operands or arguments.
+		if(auto* call = node.As<FunctionCallNode>())
+		{
+			return EmitCall(compiler, *call, true);
+		}
+
+		if(auto* block = node.As<BlockNode>())
+		{
+			return EmitBlock(compiler, *block, true);
+		}
+
+		if(auto* match = node.As<MatchExpressionNode>())
+		{
+			return EmitMatch(compiler, *match, true);
+		}
+
+		if(auto* branch = node.As<IfExpressionNode>())
+		{
+			return EmitIf(compiler, *branch, true);
+		}
+
+		return Visit(compiler, node);
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitIf(BytecodeCompiler& compiler, IfExpressionNode& node, bool tail)
+	{
+		if(auto* value = m_Folding.Find(node))
+		{
+			return EmitConstant(compiler, *value);
+		}
+
+		auto emitBranch = [&](BlockNode& block) { return EmitBlock(compiler, block, tail); };
+
+		// A constant condition only leaves the taken branch to compile.
+		if(auto* condition = m_Folding.Find(*node.GetCondition()))
+		{
+			if(condition->IsTruthy())
+			{
+				return emitBranch(*node.GetTrueBranch());
+			}
+
+			if(auto& falseBranch = node.GetFalseBranch())
+			{
+				return emitBranch(*falseBranch);
+			}
+
+			TRY(compiler.Emit<LoadNullInstruction>());
+
+			return {};
+		}
+
+		std::vector<uint32_t> falseJumps;
+		TRY(EmitConditionalJump(compiler, *node.GetCondition(), false, falseJumps));
+
+		TRY(emitBranch(*node.GetTrueBranch()));
+		auto end = TRY_RET(compiler.EmitForwardJump(Opcode::JUMP));
+
+		for(auto jump : falseJumps)
+		{
+			TRY(compiler.PatchJump(jump));
+		}
+
+		if(auto& falseBranch = node.GetFalseBranch())
+		{
+			TRY(emitBranch(*falseBranch));
+		}
+		else
+		{
+			TRY(compiler.Emit<LoadNullInstruction>());
+		}
+
+		TRY(compiler.PatchJump(end));
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitConditionalJump(BytecodeCompiler& compiler,
+																	ExpressionNode& condition, bool jumpIf,
+																	std::vector<uint32_t>& jumps)
+	{
+		using enum OperatorNode::Operator;
+
+		if(auto* value = m_Folding.Find(condition))
+		{
+			if(value->IsTruthy() == jumpIf)
+			{
+				jumps.push_back(TRY_RET(compiler.EmitForwardJump(Opcode::JUMP)));
+			}
+
+			return {};
+		}
+
+		auto* arithmetic = condition.As<ArithmeticExpressionNode>();
+		auto op = arithmetic ? arithmetic->GetOp()->GetOp() : Assign;
+
+		if(op == And || op == Or)
+		{
+			// The left operand alone decides `a && b` when it is false and `a || b` when it is true.
+			bool decidingValue = op == Or;
+			if(decidingValue == jumpIf)
+			{
+				TRY(EmitConditionalJump(compiler, *arithmetic->GetLhs(), jumpIf, jumps));
+				TRY(EmitConditionalJump(compiler, *arithmetic->GetRhs(), jumpIf, jumps));
+
+				return {};
+			}
+
+			std::vector<uint32_t> decided;
+			TRY(EmitConditionalJump(compiler, *arithmetic->GetLhs(), decidingValue, decided));
+			TRY(EmitConditionalJump(compiler, *arithmetic->GetRhs(), jumpIf, jumps));
+
+			for(auto jump : decided)
+			{
+				TRY(compiler.PatchJump(jump));
+			}
+
+			return {};
+		}
+
+		// Comparisons branch on their operands directly. Only jumping when an ordering fails is fused since
+		// NaN makes !(a < b) and a >= b differ, equality can be fused both ways.
+		std::optional<Opcode> fused;
+		switch(op)
+		{
+			case Less: fused = jumpIf ? std::nullopt : std::optional(Opcode::JUMP_IF_NOT_LT); break;
+			case Greater: fused = jumpIf ? std::nullopt : std::optional(Opcode::JUMP_IF_NOT_GT); break;
+			case LessEqual: fused = jumpIf ? std::nullopt : std::optional(Opcode::JUMP_IF_NOT_LE); break;
+			case GreaterEqual: fused = jumpIf ? std::nullopt : std::optional(Opcode::JUMP_IF_NOT_GE); break;
+			case Equal: fused = jumpIf ? Opcode::JUMP_IF_NOT_NE : Opcode::JUMP_IF_NOT_EQ; break;
+			case NotEqual: fused = jumpIf ? Opcode::JUMP_IF_NOT_EQ : Opcode::JUMP_IF_NOT_NE; break;
+			default: break;
+		}
+
+		if(fused)
+		{
+			TRY(Visit(compiler, *arithmetic->GetLhs()));
+			TRY(Visit(compiler, *arithmetic->GetRhs()));
+			jumps.push_back(TRY_RET(compiler.EmitForwardJump(*fused)));
+
+			return {};
+		}
+
+		TRY(Visit(compiler, condition));
+		jumps.push_back(TRY_RET(compiler.EmitForwardJump(jumpIf ? Opcode::JUMP_IF_TRUE : Opcode::JUMP_IF_FALSE)));
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitBlock(BytecodeCompiler& compiler, BlockNode& node, bool tail)
+	{
+		// A block evaluates to the value of its return statement, or null when it has none.
+		bool returned = false;
+		for(auto& statement : node.GetStatements())
+		{
+			// Whatever follows the return in the same block is unreachable.
+			if(auto* ret = statement->As<ReturnStatementNode>())
+			{
+				TRY(tail ? EmitTailExpression(compiler, *ret->GetExpression()) : Visit(compiler, *ret));
+
+				returned = true;
+				break;
+			}
+
+			TRY(Visit(compiler, *statement));
+		}
+
+		if(!returned)
+		{
+			TRY(compiler.Emit<LoadNullInstruction>());
+		}
+
+		// The slots are reused by the next sibling block, closures created in here must stop pointing at them.
+		// In tail position the value goes straight to RETURN or TAIL_CALL, which close everything themselves.
+		if(auto slot = m_Resolution.FindClosingSlot(node); slot && !tail)
+		{
+			TRY(compiler.Emit<CloseUpvaluesInstruction>(*slot));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitMatch(BytecodeCompiler& compiler, MatchExpressionNode& node,
+														  bool tail)
+	{
+		if(auto* value = m_Folding.Find(node))
+		{
+			return EmitConstant(compiler, *value);
+		}
+
+		auto& cases = node.GetCases();
+
+		// The scrutinee and every pattern before the taken arm are constants, nothing else needs evaluating.
+		if(auto taken = m_Folding.FindTakenCase(node))
+		{
+			if(*taken < cases.size())
+			{
+				auto& block = *cases[*taken]->GetBlock();
+				return tail ? EmitTailExpression(compiler, block) : Visit(compiler, block);
+			}
+
+			TRY(compiler.Emit<LoadNullInstruction>());
+
+			return {};
+		}
+
+		// The scrutinee stays on the stack while patterns are tested, the arm that is taken pops it.
+		TRY(Visit(compiler, *node.GetExpression()));
+
+		std::vector<uint32_t> endJumps;
+		auto emitArm = [&](MatchCaseNode& matchCase) -> BytecodeStepResult {
+			TRY(compiler.Emit<PopInstruction>());
+
+			auto& block = *matchCase.GetBlock();
+			TRY(tail ? EmitTailExpression(compiler, block) : Visit(compiler, block));
+
+			endJumps.push_back(TRY_RET(compiler.EmitForwardJump(Opcode::JUMP)));
+
+			return {};
+		};
+
+		// Runs of constant number patterns dispatch in a single instruction, the others are tested in order.
+		std::size_t i = 0;
+		while(i < cases.size())
+		{
+			auto end = i;
+			while(end < cases.size() && IsSwitchKey(*cases[end]))
+			{
+				end++;
+			}
+
+			if(end - i >= MinSwitchCases)
+			{
+				TRY(EmitSwitch(compiler, cases, i, end, emitArm));
+				i = end;
+				continue;
+			}
+
+			for(end = std::max(end, i + 1); i < end; i++)
+			{
+				TRY(compiler.Emit<DupInstruction>());
+				TRY(Visit(compiler, *cases[i]->GetPattern()));
+
+				auto next = TRY_RET(compiler.EmitForwardJump(Opcode::JUMP_IF_NOT_EQ));
+				TRY(emitArm(*cases[i]));
+				TRY(compiler.PatchJump(next));
+			}
+		}
+
+		// No arm matched.
+		TRY(compiler.Emit<PopInstruction>());
+		TRY(compiler.Emit<LoadNullInstruction>());
+
+		for(auto jump : endJumps)
+		{
+			TRY(compiler.PatchJump(jump));
+		}
+
+		return {};
+	}
+
+	bool BytecodeCompilerVisitor::IsSwitchKey(const MatchCaseNode& matchCase) const
+	{
+		auto* value = m_Folding.Find(*matchCase.GetPattern());
+
+		// A NaN pattern never matches, so it can't be looked up either.
+		return value && value->IsNumber() && !std::isnan(value->AsNumber());
+	}
+
+	BytecodeStepResult
+	BytecodeCompilerVisitor::EmitSwitch(BytecodeCompiler& compiler, const std::vector<MatchCaseNodePtr>& cases,
+										std::size_t begin, std::size_t end,
+										const std::function<BytecodeStepResult(MatchCaseNode&)>& emitArm)
+	{
+		// Sorted by key, the earliest arm first among equal keys since that is the one a match takes.
+		std::vector<std::pair<double, std::size_t>> keys;
+		for(auto i = begin; i < end; i++)
+		{
+			keys.emplace_back(m_Folding.Find(*cases[i]->GetPattern())->AsNumber(), i);
+		}
+
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end(), [](auto& a, auto& b) { return a.first == b.first; }),
+				   keys.end());
+
+		// Integers filling at least half of their range index a table directly, anything sparser is binary searched.
+		auto low = keys.front().first;
+		auto high = keys.back().first;
+		bool dense = std::all_of(keys.begin(), keys.end(),
+								 [](auto& key) {
+									 return key.first == std::trunc(key.first) && std::abs(key.first) <= MaxExactInteger;
+								 })
+					 && high - low < 2.0 * keys.size();
+
+		uint32_t table;
+		if(dense)
+		{
+			table = compiler.CurrentBuilder().AddJumpTable({low, std::vector<uint32_t>(static_cast<std::size_t>(high - low) + 1), 0});
+			TRY(compiler.Emit<SwitchTableInstruction>(table));
+		}
+		else
+		{
+			table = compiler.CurrentBuilder().AddSortedJumpTable({{}, {}, 0});
+			TRY(compiler.Emit<SwitchSortedInstruction>(table));
+		}
+
+		// Arms are laid out in source order, duplicated keys leave the later arm unreachable and it is dropped.
+		std::sort(keys.begin(), keys.end(), [](auto& a, auto& b) { return a.second < b.second; });
+
+		std::vector<std::pair<double, uint32_t>> targets;
+		for(auto& [key, index] : keys)
+		{
+			targets.emplace_back(key, compiler.CurrentOffset());
+			TRY(emitArm(*cases[index]));
+		}
+
+		// Missing keys continue with the arms after this run.
+		auto fallthrough = compiler.CurrentOffset();
+
+		if(dense)
+		{
+			auto& jumpTable = compiler.CurrentBuilder().GetJumpTable(table);
+			std::fill(jumpTable.Targets.begin(), jumpTable.Targets.end(), fallthrough);
+			for(auto& [key, target] : targets)
+			{
+				jumpTable.Targets[static_cast<std::size_t>(key - low)] = target;
+			}
+			jumpTable.Default = fallthrough;
+		}
+		else
+		{
+			std::sort(targets.begin(), targets.end());
+
+			auto& sortedTable = compiler.CurrentBuilder().GetSortedJumpTable(table);
+			for(auto& [key, target] : targets)
+			{
+				sortedTable.Keys.push_back(key);
+				sortedTable.Targets.push_back(target);
+			}
+			sortedTable.Default = fallthrough;
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::EmitFunction(BytecodeCompiler& compiler, const AstNode& node,
+															 const std::string& name,
+															 const std::vector<std::string>& params, BlockNode& body)
+	{
+		compiler.BeginFunction();
+
+		auto* enclosing = std::exchange(m_Function, &node);
+
+		// Arguments are passed in place, they already occupy the first local slots when the frame starts.
+		compiler.CurrentBuilder().SetLocalCount(m_Resolution.GetLocalCount(node));
+		compiler.CurrentBuilder().SetGlobalCount(m_Resolution.GetGlobalCount());
+
+		const ReturnStatementNode* returned = nullptr;
+		for(auto& statement : body.GetStatements())
+		{
+			if(auto* ret = statement->As<ReturnStatementNode>())
+			{
+				TRY(EmitTailExpression(compiler, *ret->GetExpression()));
+
+				returned = ret;
+				break;
+			}
+
+			TRY(Visit(compiler, *statement));
+		}
+
+		if(!returned)
+		{
+			TRY(compiler.Emit<LoadNullInstruction>());
+		}
+
+		// A tail call never comes back to this frame. Branches ending in one still jump past it, so only a call
+		// returned directly makes the RETURN unreachable.
+		auto* call = returned ? returned->GetExpression()->As<FunctionCallNode>() : nullptr;
+		if(!call || m_Escapes.CallsFrameFunction(*call))
+		{
+			TRY(compiler.Emit<ReturnInstruction>());
+		}
+
+		m_Function = enclosing;
+
+		// Functions that capture nothing are plain constants, only the others need a closure at runtime. Functions
+		// borrowing the caller frame are constants too, they read the captured slots of their caller directly.
+		auto& upvalues = m_Resolution.GetUpvalues(node);
+		auto borrowsFrame = m_Escapes.BorrowsCallerFrame(node);
+
+		uint32_t callerLocalCount = 0;
+		for(const auto& upvalue : upvalues)
+		{
+			callerLocalCount = std::max(callerLocalCount, upvalue.Index + 1);
+		}
+
+		auto constant = borrowsFrame ? compiler.EndFunction(name, params.size(), {}, callerLocalCount)
+									 : compiler.EndFunction(name, params.size(), upvalues);
+
+		if(upvalues.empty() || borrowsFrame)
+		{
+			TRY(compiler.Emit<LoadConstInstruction>(constant));
+		}
+		else
+		{
+			TRY(compiler.Emit<ClosureInstruction>(constant));
+		}
+
+		return {};
+	}
+
 	BytecodeStepResult BytecodeCompilerVisitor::Visit(BytecodeCompiler& compiler, AstNode& node)
 	{
 #define VISIT_CASE(name)                                                                                               \
@@ -53,14 +565,42 @@ namespace Glyph::Bytecode
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitExpressionStatementNode(BytecodeCompiler& compiler, ExpressionStatementNode& node)
 	{
-		N();
+		TRY(Visit(compiler, *node.GetExpression()));
+
+		// The value of an expression statement is discarded.
+		TRY(compiler.Emit<PopInstruction>());
+
+		return {};
 	}
 
 	BytecodeStepResult BytecodeCompilerVisitor::VisitProgramNode(BytecodeCompiler& compiler, ProgramNode& node)
 	{
-		for(auto& statement : node.GetStatements())
+		TRY(ScopeResolver::Resolve(node, m_Resolution));
+		ConstantFolder::Fold(node, m_Folding);
+		EscapeAnalyzer::Analyze(node, m_Resolution, m_Escapes);
+
+		compiler.CurrentBuilder().SetLocalCount(m_Resolution.GetLocalCount(node));
+		compiler.CurrentBuilder().SetGlobalCount(m_Resolution.GetGlobalCount());
+
+		auto& statements = node.GetStatements();
+		for(std::size_t i = 0; i < statements.size(); i++)
 		{
-			TRY(Visit(compiler, *statement));
+			auto& statement = *statements[i];
+
+			// A top-level return ends the program with its value, anything after it is unreachable.
+			if(statement.IsType(NodeType::ReturnStatementNode))
+			{
+				return Visit(compiler, statement);
+			}
+
+			// The value of the last expression statement is kept as the result of the program.
+			if(i == statements.size() - 1 && statement.IsType(NodeType::ExpressionStatementNode))
+			{
+				TRY(Visit(compiler, *dynamic_cast<ExpressionStatementNode&>(statement).GetExpression()));
+				continue;
+			}
+
+			TRY(Visit(compiler, statement));
 		}
 
 		return {};
@@ -75,59 +615,164 @@ namespace Glyph::Bytecode
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitArithmeticExpressionNode(BytecodeCompiler& compiler, ArithmeticExpressionNode& node)
 	{
-		N();
+		if(node.GetOp()->GetOp() == OperatorNode::Operator::Assign)
+		{
+			if(auto* index = node.GetLhs()->As<IndexExpressionNode>())
+			{
+				TRY(Visit(compiler, *index->GetObject()));
+				TRY(Visit(compiler, *index->GetKey()));
+				TRY(Visit(compiler, *node.GetRhs()));
+
+				return compiler.Emit<IndexSetInstruction>();
+			}
+
+			if(auto* field = node.GetLhs()->As<FieldExpressionNode>())
+			{
+				TRY(Visit(compiler, *field->GetObject()));
+				TRY(Visit(compiler, *node.GetRhs()));
+
+				return compiler.Emit<SetFieldInstruction>(compiler.CurrentBuilder().AddFieldCache(field->GetName()));
+			}
+
+			// The assignment is an expression itself and evaluates to the assigned value.
+			TRY(Visit(compiler, *node.GetRhs()));
+			TRY(compiler.Emit<DupInstruction>());
+
+			return EmitStore(compiler, *node.GetLhs());
+		}
+
+		if(auto* value = m_Folding.Find(node))
+		{
+			return EmitConstant(compiler, *value);
+		}
+
+		TRY(Visit(compiler, *node.GetLhs()));
+
+		// Evaluates to the left operand when it decides the result, the right operand is only evaluated otherwise.
+		if(auto op = node.GetOp()->GetOp(); op == OperatorNode::Operator::And || op == OperatorNode::Operator::Or)
+		{
+			TRY(compiler.Emit<DupInstruction>());
+			auto end = TRY_RET(
+				compiler.EmitForwardJump(op == OperatorNode::Operator::And ? Opcode::JUMP_IF_FALSE : Opcode::JUMP_IF_TRUE));
+
+			TRY(compiler.Emit<PopInstruction>());
+			TRY(Visit(compiler, *node.GetRhs()));
+			TRY(compiler.PatchJump(end));
+
+			return {};
+		}
+
+		TRY(Visit(compiler, *node.GetRhs()));
+
+		return VisitOperatorNode(compiler, *node.GetOp());
 	}
 
-	BytecodeStepResult BytecodeCompilerVisitor::VisitBlockNode(BytecodeCompiler& compiler, BlockNode& node) { N(); }
+	BytecodeStepResult BytecodeCompilerVisitor::VisitBlockNode(BytecodeCompiler& compiler, BlockNode& node)
+	{
+		return EmitBlock(compiler, node, false);
+	}
+
+	BytecodeStepResult
+	BytecodeCompilerVisitor::VisitArrayLiteralNode(BytecodeCompiler& compiler, ArrayLiteralNode& node)
+	{
+		for(auto& element : node.GetElements())
+		{
+			TRY(Visit(compiler, *element));
+		}
+
+		return compiler.Emit<ArrayNewInstruction>(static_cast<uint32_t>(node.GetElements().size()));
+	}
+
+	BytecodeStepResult BytecodeCompilerVisitor::VisitDictLiteralNode(BytecodeCompiler& compiler, DictLiteralNode& node)
+	{
+		for(auto& [key, value] : node.GetEntries())
+		{
+			TRY(Visit(compiler, *key));
+			TRY(Visit(compiler, *value));
+		}
+
+		return compiler.Emit<DictNewInstruction>(static_cast<uint32_t>(node.GetEntries().size()));
+	}
+
+	BytecodeStepResult
+	BytecodeCompilerVisitor::VisitRecordLiteralNode(BytecodeCompiler& compiler, RecordLiteralNode& node)
+	{
+		std::vector<std::string> fields;
+		for(auto& [name, value] : node.GetFields())
+		{
+			TRY(Visit(compiler, *value));
+			fields.push_back(name);
+		}
+
+		return compiler.Emit<RecordNewInstruction>(compiler.CurrentBuilder().AddRecordLayout(std::move(fields)));
+	}
 
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitFunctionCallNode(BytecodeCompiler& compiler, FunctionCallNode& node)
 	{
-		N();
+		return EmitCall(compiler, node, false);
 	}
 
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitFunctionDeclarationNode(BytecodeCompiler& compiler, FunctionDeclarationNode& node)
 	{
-		N();
+		auto& prototype = *node.GetPrototype();
+
+		TRY(EmitFunction(compiler, node, prototype.GetName()->GetName(), prototype.GetArgs(), *node.GetBlock()));
+
+		return EmitStore(compiler, node);
 	}
 
 	BytecodeStepResult BytecodeCompilerVisitor::VisitIdentifierNode(BytecodeCompiler& compiler, IdentifierNode& node)
 	{
-		N();
+		return EmitLoad(compiler, node);
 	}
 
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitIfExpressionNode(BytecodeCompiler& compiler, IfExpressionNode& node)
 	{
-		N();
+		return EmitIf(compiler, node, false);
+	}
+
+	BytecodeStepResult
+	BytecodeCompilerVisitor::VisitIndexExpressionNode(BytecodeCompiler& compiler, IndexExpressionNode& node)
+	{
+		TRY(Visit(compiler, *node.GetObject()));
+		TRY(Visit(compiler, *node.GetKey()));
+
+		return compiler.Emit<IndexGetInstruction>();
+	}
+
+	BytecodeStepResult
+	BytecodeCompilerVisitor::VisitFieldExpressionNode(BytecodeCompiler& compiler, FieldExpressionNode& node)
+	{
+		TRY(Visit(compiler, *node.GetObject()));
+
+		return compiler.Emit<GetFieldInstruction>(compiler.CurrentBuilder().AddFieldCache(node.GetName()));
 	}
 
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitLetDeclarationNode(BytecodeCompiler& compiler, LetDeclarationNode& node)
 	{
-		// Load the value (LOAD_CONST)
 		TRY(Visit(compiler, *node.GetExpression()));
 
-		// FIXME: load the identifier (STORE_NAME)
-		//		compiler.EmitInstruction(BytecodeInstruction::STORE_NAME, node.GetIdentifier()->GetName());
-
-		return {};
+		return EmitStore(compiler, node);
 	}
 
 	BytecodeStepResult BytecodeCompilerVisitor::VisitLiteralNode(BytecodeCompiler& compiler, LiteralNode& node)
 	{
-		auto constant = compiler.MakeConstant(node.GetValue());
-
-		TRY(compiler.Emit<LoadConstInstruction>(constant));
+		if(node.IsString())
+		{
+			return EmitConstant(compiler, Value(compiler.InternString(node.GetString())));
+		}
 
-		return {};
+		return EmitConstant(compiler, node.GetValue());
 	}
 
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitMatchExpressionNode(BytecodeCompiler& compiler, MatchExpressionNode& node)
 	{
-		N();
+		return EmitMatch(compiler, node, false);
 	}
 
 	BytecodeStepResult BytecodeCompilerVisitor::VisitMatchCaseNode(BytecodeCompiler& compiler, MatchCaseNode& node)
@@ -137,7 +782,24 @@ namespace Glyph::Bytecode
 
 	BytecodeStepResult BytecodeCompilerVisitor::VisitOperatorNode(BytecodeCompiler& compiler, OperatorNode& node)
 	{
-		N();
+		// Both operands are on the stack, lhs below rhs.
+		switch(node.GetOp())
+		{
+			case OperatorNode::Operator::Plus: TRY(compiler.Emit<AddInstruction>()); break;
+			case OperatorNode::Operator::Minus: TRY(compiler.Emit<SubInstruction>()); break;
+			case OperatorNode::Operator::Star: TRY(compiler.Emit<MulInstruction>()); break;
+			case OperatorNode::Operator::Slash: TRY(compiler.Emit<DivInstruction>()); break;
+			case OperatorNode::Operator::Less: TRY(compiler.Emit<LessInstruction>()); break;
+			case OperatorNode::Operator::Greater: TRY(compiler.Emit<GreaterInstruction>()); break;
+			case OperatorNode::Operator::Equal: TRY(compiler.Emit<EqualInstruction>()); break;
+			case OperatorNode::Operator::NotEqual: TRY(compiler.Emit<NotEqualInstruction>()); break;
+			case OperatorNode::Operator::LessEqual: TRY(compiler.Emit<LessEqualInstruction>()); break;
+			case OperatorNode::Operator::GreaterEqual: TRY(compiler.Emit<GreaterEqualInstruction>()); break;
+			case OperatorNode::Operator::In: TRY(compiler.Emit<DictContainsInstruction>()); break;
+			default: N();
+		}
+
+		return {};
 	}
 
 	BytecodeStepResult BytecodeCompilerVisitor::VisitPrototypeNode(BytecodeCompiler& compiler, PrototypeNode& node)
@@ -148,13 +810,14 @@ namespace Glyph::Bytecode
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitReturnStatementNode(BytecodeCompiler& compiler, ReturnStatementNode& node)
 	{
-		N();
+		// Leaves the value on the stack as the result of the enclosing block.
+		return Visit(compiler, *node.GetExpression());
 	}
 
 	BytecodeStepResult
 	BytecodeCompilerVisitor::VisitLambdaExpressionNode(BytecodeCompiler& compiler, LambdaExpressionNode& node)
 	{
-		N();
+		return EmitFunction(compiler, node, "lambda", node.GetArgs(), *node.GetBlock());
 	}
 
 } // namespace Glyph::Bytecode
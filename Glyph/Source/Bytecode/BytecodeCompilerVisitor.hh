@@ -3,11 +3,24 @@
 #include <AST/AST.hh>
 #include <Bytecode/BytecodeCompiler.hh>
 #include <Bytecode/BytecodeStepResult.hh>
+#include <Bytecode/ConstantFolder.hh>
+#include <Bytecode/EscapeAnalyzer.hh>
+#include <Bytecode/ScopeResolver.hh>
+
+#include <functional>
+#include <optional>
+#include <vector>
 
 namespace Glyph::Bytecode
 {
 	class BytecodeCompilerVisitor
 	{
+	  public:
+		/// @brief Fewer constant cases than this in a row are cheaper to test one by one.
+		static constexpr std::size_t MinSwitchCases = 4;
+		/// @brief Largest magnitude up to which every integer is exactly representable as a double.
+		static constexpr double MaxExactInteger = 9007199254740992.0;
+
 	  public:
 		BytecodeCompilerVisitor(std::ostream& debugStream);
 
@@ -17,7 +30,44 @@ namespace Glyph::Bytecode
 
 			BytecodeStepResult Visit(BytecodeCompiler& compiler, AstNode& node);
 
+	  private:
+		BytecodeStepResult EmitLoad(BytecodeCompiler& compiler, const AstNode& node);
+		BytecodeStepResult EmitStore(BytecodeCompiler& compiler, const AstNode& node);
+		BytecodeStepResult EmitConstant(BytecodeCompiler& compiler, const Value& value);
+
+		/// @brief Pushes callee and arguments, then calls. A tail call replaces the current frame instead.
+		BytecodeStepResult EmitCall(BytecodeCompiler& compiler, FunctionCallNode& node, bool tail);
+
+		/// @brief Compiles an expression whose value the function returns unchanged, calls in it become tail calls.
+		BytecodeStepResult EmitTailExpression(BytecodeCompiler& compiler, ExpressionNode& node);
+		BytecodeStepResult EmitBlock(BytecodeCompiler& compiler, BlockNode& node, bool tail);
+		BytecodeStepResult EmitMatch(BytecodeCompiler& compiler, MatchExpressionNode& node, bool tail);
+		BytecodeStepResult EmitIf(BytecodeCompiler& compiler, IfExpressionNode& node, bool tail);
+
+		/// @brief Emits jumps, collected for the caller to patch, taken when the truthiness of the condition is
+		/// jumpIf. Falls through otherwise. Never materializes the bool of a comparison, && or ||.
+		BytecodeStepResult EmitConditionalJump(BytecodeCompiler& compiler, ExpressionNode& condition, bool jumpIf,
+											   std::vector<uint32_t>& jumps);
+
+		/// @brief Whether the pattern of a case is a number known at compile time, usable as a jump table key.
+		[[nodiscard]] bool IsSwitchKey(const MatchCaseNode& matchCase) const;
+
+		/// @brief Dispatches the cases [begin, end), all with constant number patterns, through a jump table.
+		BytecodeStepResult EmitSwitch(BytecodeCompiler& compiler, const std::vector<MatchCaseNodePtr>& cases,
+									  std::size_t begin, std::size_t end,
+									  const std::function<BytecodeStepResult(MatchCaseNode&)>& emitArm);
+
+		/// @brief Compiles a function body into its own chunk and loads the resulting function onto the stack.
+		BytecodeStepResult EmitFunction(BytecodeCompiler& compiler, const AstNode& node, const std::string& name,
+										const std::vector<std::string>& params, BlockNode& body);
+
 	  private:
 		std::ostream& m_DebugStream;
+		ScopeResolution m_Resolution;
+		ConstantFolding m_Folding;
+		EscapeAnalysis m_Escapes;
+
+		/// @brief Function whose body is being compiled, nullptr at the top level.
+		const AstNode* m_Function {nullptr};
 	};
 } // namespace Glyph::Bytecode
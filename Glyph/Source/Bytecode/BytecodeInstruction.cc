@@ -4,37 +4,193 @@
 
 namespace Glyph::Bytecode
 {
-	Instruction::Instruction(Opcode type)
-		: m_Type(type)
+	std::string Instruction::ToString(Opcode type, uint32_t operand)
+	{
+		switch(type)
+		{
+			case Opcode::WIDE:
+			case Opcode::LOAD_CONST:
+			case Opcode::LOAD_LOCAL:
+			case Opcode::STORE_LOCAL:
+			case Opcode::LOAD_GLOBAL:
+			case Opcode::STORE_GLOBAL:
+			case Opcode::LOAD_UPVALUE:
+			case Opcode::STORE_UPVALUE:
+			case Opcode::CLOSURE:
+			case Opcode::CLOSE_UPVALUES:
+			case Opcode::LOAD_CALLER_LOCAL:
+			case Opcode::STORE_CALLER_LOCAL:
+			case Opcode::ARRAY_NEW:
+			case Opcode::DICT_NEW:
+			case Opcode::RECORD_NEW:
+			case Opcode::GET_FIELD:
+			case Opcode::SET_FIELD:
+			case Opcode::JUMP:
+			case Opcode::JUMP_IF_FALSE:
+			case Opcode::JUMP_IF_TRUE:
+			case Opcode::JUMP_IF_NOT_LT:
+			case Opcode::JUMP_IF_NOT_GT:
+			case Opcode::JUMP_IF_NOT_LE:
+			case Opcode::JUMP_IF_NOT_GE:
+			case Opcode::JUMP_IF_NOT_EQ:
+			case Opcode::JUMP_IF_NOT_NE:
+			case Opcode::SWITCH_TABLE:
+			case Opcode::SWITCH_SORTED:
+			case Opcode::CALL:
+			case Opcode::TAIL_CALL:
+				return std::string(magic_enum::enum_name(type)) + "(" + std::to_string(operand) + ")";
+
+			default: return std::string(magic_enum::enum_name(type));
+		}
+	}
+
+	WideInstruction::WideInstruction(uint32_t highBits)
+		: Instruction(Opcode::WIDE, highBits)
 	{
 	}
 
 	LoadConstInstruction::LoadConstInstruction(ConstantTableIndex index)
-		: Instruction(Opcode::LOAD_CONST)
-		, m_Index(index)
+		: Instruction(Opcode::LOAD_CONST, index)
 	{
 	}
 
-	void LoadConstInstruction::Execute(VM& vm) {}
+	LoadLocalInstruction::LoadLocalInstruction(uint32_t slot)
+		: Instruction(Opcode::LOAD_LOCAL, slot)
+	{
+	}
 
-	std::string LoadConstInstruction::ToString() const { return "LOAD_CONST(" + std::to_string(m_Index) + ")"; }
+	StoreLocalInstruction::StoreLocalInstruction(uint32_t slot)
+		: Instruction(Opcode::STORE_LOCAL, slot)
+	{
+	}
 
-	StoreNameInstruction::StoreNameInstruction(ConstantTableIndex index)
-		: Instruction(Opcode::STORE_NAME)
-		, m_Index(index)
+	LoadGlobalInstruction::LoadGlobalInstruction(uint32_t index)
+		: Instruction(Opcode::LOAD_GLOBAL, index)
 	{
 	}
 
-	void StoreNameInstruction::Execute(VM& vm) {}
+	StoreGlobalInstruction::StoreGlobalInstruction(uint32_t index)
+		: Instruction(Opcode::STORE_GLOBAL, index)
+	{
+	}
 
-	std::string StoreNameInstruction::ToString() const { return "STORE_NAME(" + std::to_string(m_Index) + ")"; }
+	LoadUpvalueInstruction::LoadUpvalueInstruction(uint32_t index)
+		: Instruction(Opcode::LOAD_UPVALUE, index)
+	{
+	}
+
+	StoreUpvalueInstruction::StoreUpvalueInstruction(uint32_t index)
+		: Instruction(Opcode::STORE_UPVALUE, index)
+	{
+	}
 
-	EndInstruction::EndInstruction()
-		: Instruction(Opcode::END)
+	ClosureInstruction::ClosureInstruction(ConstantTableIndex index)
+		: Instruction(Opcode::CLOSURE, index)
 	{
 	}
 
-	void EndInstruction::Execute(VM& vm) {}
+	CloseUpvaluesInstruction::CloseUpvaluesInstruction(uint32_t slot)
+		: Instruction(Opcode::CLOSE_UPVALUES, slot)
+	{
+	}
+
+	LoadCallerLocalInstruction::LoadCallerLocalInstruction(uint32_t slot)
+		: Instruction(Opcode::LOAD_CALLER_LOCAL, slot)
+	{
+	}
+
+	StoreCallerLocalInstruction::StoreCallerLocalInstruction(uint32_t slot)
+		: Instruction(Opcode::STORE_CALLER_LOCAL, slot)
+	{
+	}
+
+#define DEFINE_JUMP_INSTRUCTION(opcode, name)                                                                          \
+	name##Instruction::name##Instruction(uint32_t target)                                                              \
+		: Instruction(Opcode::opcode, target)                                                                          \
+	{                                                                                                                  \
+	}
+
+	DEFINE_JUMP_INSTRUCTION(JUMP, Jump)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_FALSE, JumpIfFalse)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_TRUE, JumpIfTrue)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_NOT_LT, JumpIfNotLess)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_NOT_GT, JumpIfNotGreater)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_NOT_LE, JumpIfNotLessEqual)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_NOT_GE, JumpIfNotGreaterEqual)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_NOT_EQ, JumpIfNotEqual)
+	DEFINE_JUMP_INSTRUCTION(JUMP_IF_NOT_NE, JumpIfEqual)
+
+#undef DEFINE_JUMP_INSTRUCTION
+
+	SwitchTableInstruction::SwitchTableInstruction(uint32_t table)
+		: Instruction(Opcode::SWITCH_TABLE, table)
+	{
+	}
+
+	SwitchSortedInstruction::SwitchSortedInstruction(uint32_t table)
+		: Instruction(Opcode::SWITCH_SORTED, table)
+	{
+	}
+
+	ArrayNewInstruction::ArrayNewInstruction(uint32_t elementCount)
+		: Instruction(Opcode::ARRAY_NEW, elementCount)
+	{
+	}
+
+	DictNewInstruction::DictNewInstruction(uint32_t entryCount)
+		: Instruction(Opcode::DICT_NEW, entryCount)
+	{
+	}
+
+	RecordNewInstruction::RecordNewInstruction(uint32_t layout)
+		: Instruction(Opcode::RECORD_NEW, layout)
+	{
+	}
+
+	GetFieldInstruction::GetFieldInstruction(uint32_t cache)
+		: Instruction(Opcode::GET_FIELD, cache)
+	{
+	}
+
+	SetFieldInstruction::SetFieldInstruction(uint32_t cache)
+		: Instruction(Opcode::SET_FIELD, cache)
+	{
+	}
+
+	CallInstruction::CallInstruction(uint32_t argumentCount)
+		: Instruction(Opcode::CALL, argumentCount)
+	{
+	}
+
+	TailCallInstruction::TailCallInstruction(uint32_t argumentCount)
+		: Instruction(Opcode::TAIL_CALL, argumentCount)
+	{
+	}
+
+#define DEFINE_SIMPLE_INSTRUCTION(opcode, name)                                                                        \
+	name##Instruction::name##Instruction()                                                                             \
+		: Instruction(Opcode::opcode, 0)                                                                               \
+	{                                                                                                                  \
+	}
+
+	DEFINE_SIMPLE_INSTRUCTION(LOAD_NULL, LoadNull)
+	DEFINE_SIMPLE_INSTRUCTION(POP, Pop)
+	DEFINE_SIMPLE_INSTRUCTION(DUP, Dup)
+	DEFINE_SIMPLE_INSTRUCTION(ADD, Add)
+	DEFINE_SIMPLE_INSTRUCTION(SUB, Sub)
+	DEFINE_SIMPLE_INSTRUCTION(MUL, Mul)
+	DEFINE_SIMPLE_INSTRUCTION(DIV, Div)
+	DEFINE_SIMPLE_INSTRUCTION(LESS, Less)
+	DEFINE_SIMPLE_INSTRUCTION(GREATER, Greater)
+	DEFINE_SIMPLE_INSTRUCTION(EQUAL, Equal)
+	DEFINE_SIMPLE_INSTRUCTION(NOT_EQUAL, NotEqual)
+	DEFINE_SIMPLE_INSTRUCTION(LESS_EQUAL, LessEqual)
+	DEFINE_SIMPLE_INSTRUCTION(GREATER_EQUAL, GreaterEqual)
+	DEFINE_SIMPLE_INSTRUCTION(INDEX_GET, IndexGet)
+	DEFINE_SIMPLE_INSTRUCTION(INDEX_SET, IndexSet)
+	DEFINE_SIMPLE_INSTRUCTION(DICT_CONTAINS, DictContains)
+	DEFINE_SIMPLE_INSTRUCTION(RETURN, Return)
+	DEFINE_SIMPLE_INSTRUCTION(END, End)
 
-	std::string EndInstruction::ToString() const { return "END"; }
+#undef DEFINE_SIMPLE_INSTRUCTION
 } // namespace Glyph::Bytecode
@@ -3,104 +3,388 @@
 #include <Runtime/ConstantTable.hh>
 
 #include <cstdint>
+#include <string>
 
 namespace Glyph::Bytecode
 {
-	class VM;
 #define INSTRUCTION_LIST(V)                                                                                            \
+	V(WIDE, Wide)                                                                                                      \
 	V(LOAD_CONST, LoadConst)                                                                                           \
-	V(STORE_NAME, StoreName)                                                                                           \
+	V(LOAD_NULL, LoadNull)                                                                                             \
+	V(LOAD_LOCAL, LoadLocal)                                                                                           \
+	V(STORE_LOCAL, StoreLocal)                                                                                         \
+	V(LOAD_GLOBAL, LoadGlobal)                                                                                         \
+	V(STORE_GLOBAL, StoreGlobal)                                                                                       \
+	V(LOAD_UPVALUE, LoadUpvalue)                                                                                       \
+	V(STORE_UPVALUE, StoreUpvalue)                                                                                     \
+	V(CLOSURE, Closure)                                                                                                \
+	V(CLOSE_UPVALUES, CloseUpvalues)                                                                                   \
+	V(LOAD_CALLER_LOCAL, LoadCallerLocal)                                                                              \
+	V(STORE_CALLER_LOCAL, StoreCallerLocal)                                                                            \
+	V(POP, Pop)                                                                                                        \
+	V(DUP, Dup)                                                                                                        \
 	V(ADD, Add)                                                                                                        \
+	V(SUB, Sub)                                                                                                        \
+	V(MUL, Mul)                                                                                                        \
+	V(DIV, Div)                                                                                                        \
+	V(LESS, Less)                                                                                                      \
+	V(GREATER, Greater)                                                                                                \
+	V(EQUAL, Equal)                                                                                                    \
+	V(NOT_EQUAL, NotEqual)                                                                                             \
+	V(LESS_EQUAL, LessEqual)                                                                                           \
+	V(GREATER_EQUAL, GreaterEqual)                                                                                     \
+	V(ARRAY_NEW, ArrayNew)                                                                                             \
+	V(DICT_NEW, DictNew)                                                                                               \
+	V(INDEX_GET, IndexGet)                                                                                             \
+	V(INDEX_SET, IndexSet)                                                                                             \
+	V(DICT_CONTAINS, DictContains)                                                                                     \
+	V(RECORD_NEW, RecordNew)                                                                                           \
+	V(GET_FIELD, GetField)                                                                                             \
+	V(SET_FIELD, SetField)                                                                                             \
+	V(JUMP, Jump)                                                                                                      \
+	V(JUMP_IF_FALSE, JumpIfFalse)                                                                                      \
+	V(JUMP_IF_TRUE, JumpIfTrue)                                                                                        \
+	V(JUMP_IF_NOT_LT, JumpIfNotLess)                                                                                   \
+	V(JUMP_IF_NOT_GT, JumpIfNotGreater)                                                                                \
+	V(JUMP_IF_NOT_LE, JumpIfNotLessEqual)                                                                              \
+	V(JUMP_IF_NOT_GE, JumpIfNotGreaterEqual)                                                                           \
+	V(JUMP_IF_NOT_EQ, JumpIfNotEqual)                                                                                  \
+	V(JUMP_IF_NOT_NE, JumpIfEqual)                                                                                     \
+	V(SWITCH_TABLE, SwitchTable)                                                                                       \
+	V(SWITCH_SORTED, SwitchSorted)                                                                                     \
+	V(CALL, Call)                                                                                                      \
+	V(TAIL_CALL, TailCall)                                                                                             \
 	V(RETURN, Return)                                                                                                  \
 	V(END, End)
 
 #define DECLARE_ENUM_TYPE(name, _) name,
-	enum class Opcode
+	enum class Opcode : uint8_t
 	{
 		INSTRUCTION_LIST(DECLARE_ENUM_TYPE)
 	};
 #undef DECLARE_ENUM_TYPE
 
-	class alignas(void*) Instruction
+#define COUNT_OPCODE(name, _) +1
+	constexpr std::size_t OpcodeCount = 0 INSTRUCTION_LIST(COUNT_OPCODE);
+#undef COUNT_OPCODE
+
+	/// @brief A single 32-bit instruction word, the opcode in the low byte and a 24-bit operand above it.
+	/// Operands that don't fit are preceded by a WIDE word carrying the upper 8 bits.
+	class Instruction
 	{
 	  public:
-		// NOTE: No virtual functions due to it being copied into the bytecode list and sizeof doesn't account for it.
+		static constexpr uint32_t OpcodeBits = 8;
+		static constexpr uint32_t OperandBits = 24;
+		static constexpr uint32_t MaxOperand = (1u << OperandBits) - 1;
+
+	  public:
+		constexpr Instruction() = default;
+		constexpr Instruction(Opcode type, uint32_t operand)
+			: m_Word(static_cast<uint32_t>(type) | (operand << OpcodeBits))
+		{
+		}
+
 		Instruction(const Instruction&) = default;
 
-		[[nodiscard]] Opcode GetType() const { return m_Type; }
-		[[nodiscard]] bool IsType(Opcode type) const { return m_Type == type; }
+		[[nodiscard]] Opcode GetType() const { return static_cast<Opcode>(m_Word & 0xFF); }
+		[[nodiscard]] bool IsType(Opcode type) const { return GetType() == type; }
+		[[nodiscard]] uint32_t GetOperand() const { return m_Word >> OpcodeBits; }
 
-		//		virtual void Execute(class VM&) = 0;
-		//		virtual std::string ToString() const = 0;
+		[[nodiscard]] uint32_t GetWord() const { return m_Word; }
 
-	  protected:
-		explicit Instruction(Opcode type);
+		/// @brief Disassembles an instruction, operand is the full (WIDE extended) operand.
+		[[nodiscard]] static std::string ToString(Opcode type, uint32_t operand);
 
 	  private:
-		Opcode m_Type;
+		uint32_t m_Word {0};
+	};
+
+	static_assert(sizeof(Instruction) == sizeof(uint32_t));
+
+	class WideInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::WIDE;
+
+		explicit WideInstruction(uint32_t highBits);
 	};
 
 	class LoadConstInstruction : public Instruction
 	{
 	  public:
+		static constexpr Opcode Type = Opcode::LOAD_CONST;
+
 		explicit LoadConstInstruction(ConstantTableIndex index);
 
-		LoadConstInstruction(const LoadConstInstruction&) = default;
+		ConstantTableIndex Index() const { return GetOperand(); }
+	};
 
-		void Execute(VM& vm);
-		[[nodiscard]] std::string ToString() const;
+	// Operand is the slot index in the current frame.
+	class LoadLocalInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::LOAD_LOCAL;
 
-		ConstantTableIndex Index() const { return m_Index; }
+		explicit LoadLocalInstruction(uint32_t slot);
 
-	  private:
-		ConstantTableIndex m_Index;
+		uint32_t Slot() const { return GetOperand(); }
 	};
 
-	class StoreNameInstruction : public Instruction
+	class StoreLocalInstruction : public Instruction
 	{
 	  public:
-		explicit StoreNameInstruction(ConstantTableIndex index);
+		static constexpr Opcode Type = Opcode::STORE_LOCAL;
 
-		StoreNameInstruction(const StoreNameInstruction&) = default;
+		explicit StoreLocalInstruction(uint32_t slot);
 
-		void Execute(VM& vm);
-		[[nodiscard]] std::string ToString() const;
+		uint32_t Slot() const { return GetOperand(); }
+	};
 
-	  private:
-		ConstantTableIndex m_Index;
+	// Operand is the index into the global table.
+	class LoadGlobalInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::LOAD_GLOBAL;
+
+		explicit LoadGlobalInstruction(uint32_t index);
+
+		uint32_t Index() const { return GetOperand(); }
+	};
+
+	class StoreGlobalInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::STORE_GLOBAL;
+
+		explicit StoreGlobalInstruction(uint32_t index);
+
+		uint32_t Index() const { return GetOperand(); }
 	};
 
-	class AddInstruction : public Instruction
+	// Operand is the index into the upvalues of the running closure.
+	class LoadUpvalueInstruction : public Instruction
 	{
 	  public:
-		AddInstruction();
+		static constexpr Opcode Type = Opcode::LOAD_UPVALUE;
 
-		AddInstruction(const AddInstruction&) = default;
+		explicit LoadUpvalueInstruction(uint32_t index);
 
-		void Execute(VM& vm);
-		[[nodiscard]] std::string ToString() const;
+		uint32_t Index() const { return GetOperand(); }
 	};
 
-	class ReturnInstruction : public Instruction
+	class StoreUpvalueInstruction : public Instruction
 	{
 	  public:
-		ReturnInstruction();
+		static constexpr Opcode Type = Opcode::STORE_UPVALUE;
 
-		ReturnInstruction(const ReturnInstruction&) = default;
+		explicit StoreUpvalueInstruction(uint32_t index);
 
-		void Execute(VM& vm);
-		[[nodiscard]] std::string ToString() const;
+		uint32_t Index() const { return GetOperand(); }
 	};
 
-	class EndInstruction : public Instruction
+	// Operand is the constant holding the FunctionObject, pushes a closure capturing its upvalues.
+	class ClosureInstruction : public Instruction
 	{
 	  public:
-		EndInstruction();
+		static constexpr Opcode Type = Opcode::CLOSURE;
 
-		EndInstruction(const EndInstruction&) = default;
+		explicit ClosureInstruction(ConstantTableIndex index);
 
-		void Execute(VM& vm);
-		[[nodiscard]] std::string ToString() const;
+		ConstantTableIndex Index() const { return GetOperand(); }
 	};
 
+	// Closes every open upvalue pointing at the given local slot or above, emitted when a block with captured
+	// locals ends.
+	class CloseUpvaluesInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::CLOSE_UPVALUES;
+
+		explicit CloseUpvaluesInstruction(uint32_t slot);
+
+		uint32_t Slot() const { return GetOperand(); }
+	};
+
+	// Operand is a local slot of the calling frame, used by local functions that never escape the frame defining them.
+	class LoadCallerLocalInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::LOAD_CALLER_LOCAL;
+
+		explicit LoadCallerLocalInstruction(uint32_t slot);
+
+		uint32_t Slot() const { return GetOperand(); }
+	};
+
+	class StoreCallerLocalInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::STORE_CALLER_LOCAL;
+
+		explicit StoreCallerLocalInstruction(uint32_t slot);
+
+		uint32_t Slot() const { return GetOperand(); }
+	};
+
+	// Operand is the number of elements pushed before it, all numbers. Replaced by a Float64ArrayObject holding them.
+	class ArrayNewInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::ARRAY_NEW;
+
+		explicit ArrayNewInstruction(uint32_t elementCount);
+
+		uint32_t ElementCount() const { return GetOperand(); }
+	};
+
+	// Operand is the number of key/value pairs pushed before it, each key below its value. Replaced by the dict.
+	class DictNewInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::DICT_NEW;
+
+		explicit DictNewInstruction(uint32_t entryCount);
+
+		uint32_t EntryCount() const { return GetOperand(); }
+	};
+
+	// Operand is the index of a RecordLayout of the chunk, one value per field pushed before it in layout order.
+	// Replaced by the record.
+	class RecordNewInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::RECORD_NEW;
+
+		explicit RecordNewInstruction(uint32_t layout);
+
+		uint32_t Layout() const { return GetOperand(); }
+	};
+
+	// Operand is the index of the FieldCache of this instruction in the chunk, it names the field.
+	// [record] -> value
+	class GetFieldInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::GET_FIELD;
+
+		explicit GetFieldInstruction(uint32_t cache);
+
+		uint32_t Cache() const { return GetOperand(); }
+	};
+
+	// [record value] -> value
+	class SetFieldInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::SET_FIELD;
+
+		explicit SetFieldInstruction(uint32_t cache);
+
+		uint32_t Cache() const { return GetOperand(); }
+	};
+
+	// Operand is the absolute index of the target instruction in the chunk.
+#define DECLARE_JUMP_INSTRUCTION(opcode, name)                                                                         \
+	class name##Instruction : public Instruction                                                                       \
+	{                                                                                                                  \
+	  public:                                                                                                          \
+		static constexpr Opcode Type = Opcode::opcode;                                                                 \
+                                                                                                                       \
+		explicit name##Instruction(uint32_t target);                                                                   \
+                                                                                                                       \
+		uint32_t Target() const { return GetOperand(); }                                                               \
+	};
+
+	DECLARE_JUMP_INSTRUCTION(JUMP, Jump)
+	// Pop the condition and jump when it is falsy / truthy.
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_FALSE, JumpIfFalse)
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_TRUE, JumpIfTrue)
+	// Pop both operands of a comparison and jump when it does not hold, without pushing a bool in between.
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_NOT_LT, JumpIfNotLess)
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_NOT_GT, JumpIfNotGreater)
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_NOT_LE, JumpIfNotLessEqual)
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_NOT_GE, JumpIfNotGreaterEqual)
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_NOT_EQ, JumpIfNotEqual)
+	DECLARE_JUMP_INSTRUCTION(JUMP_IF_NOT_NE, JumpIfEqual)
+
+#undef DECLARE_JUMP_INSTRUCTION
+
+	// Operand is the index of a JumpTable of the chunk, the scrutinee is left on the stack.
+	class SwitchTableInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::SWITCH_TABLE;
+
+		explicit SwitchTableInstruction(uint32_t table);
+
+		uint32_t Table() const { return GetOperand(); }
+	};
+
+	// Operand is the index of a SortedJumpTable of the chunk, the scrutinee is left on the stack.
+	class SwitchSortedInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::SWITCH_SORTED;
+
+		explicit SwitchSortedInstruction(uint32_t table);
+
+		uint32_t Table() const { return GetOperand(); }
+	};
+
+	// Operand is the number of arguments pushed after the callee.
+	class CallInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::CALL;
+
+		explicit CallInstruction(uint32_t argumentCount);
+
+		uint32_t ArgumentCount() const { return GetOperand(); }
+	};
+
+	// Like CALL, but replaces the current frame with the callee's so the stack does not grow.
+	class TailCallInstruction : public Instruction
+	{
+	  public:
+		static constexpr Opcode Type = Opcode::TAIL_CALL;
+
+		explicit TailCallInstruction(uint32_t argumentCount);
+
+		uint32_t ArgumentCount() const { return GetOperand(); }
+	};
+
+	// Instructions without operands only differ in their opcode.
+#define DECLARE_SIMPLE_INSTRUCTION(opcode, name)                                                                       \
+	class name##Instruction : public Instruction                                                                       \
+	{                                                                                                                  \
+	  public:                                                                                                          \
+		static constexpr Opcode Type = Opcode::opcode;                                                                 \
+                                                                                                                       \
+		name##Instruction();                                                                                           \
+	};
+
+	DECLARE_SIMPLE_INSTRUCTION(LOAD_NULL, LoadNull)
+	DECLARE_SIMPLE_INSTRUCTION(POP, Pop)
+	DECLARE_SIMPLE_INSTRUCTION(DUP, Dup)
+	DECLARE_SIMPLE_INSTRUCTION(ADD, Add)
+	DECLARE_SIMPLE_INSTRUCTION(SUB, Sub)
+	DECLARE_SIMPLE_INSTRUCTION(MUL, Mul)
+	DECLARE_SIMPLE_INSTRUCTION(DIV, Div)
+	DECLARE_SIMPLE_INSTRUCTION(LESS, Less)
+	DECLARE_SIMPLE_INSTRUCTION(GREATER, Greater)
+	DECLARE_SIMPLE_INSTRUCTION(EQUAL, Equal)
+	DECLARE_SIMPLE_INSTRUCTION(NOT_EQUAL, NotEqual)
+	DECLARE_SIMPLE_INSTRUCTION(LESS_EQUAL, LessEqual)
+	DECLARE_SIMPLE_INSTRUCTION(GREATER_EQUAL, GreaterEqual)
+	// [object key] -> value. A key missing from a dict gives null, an array index out of range is an error.
+	DECLARE_SIMPLE_INSTRUCTION(INDEX_GET, IndexGet)
+	// [object key value] -> value
+	DECLARE_SIMPLE_INSTRUCTION(INDEX_SET, IndexSet)
+	// [key dict] -> bool, the operand order of 'key in dict'.
+	DECLARE_SIMPLE_INSTRUCTION(DICT_CONTAINS, DictContains)
+	DECLARE_SIMPLE_INSTRUCTION(RETURN, Return)
+	DECLARE_SIMPLE_INSTRUCTION(END, End)
+
+#undef DECLARE_SIMPLE_INSTRUCTION
+
 } // namespace Glyph::Bytecode
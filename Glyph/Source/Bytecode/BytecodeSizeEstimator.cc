@@ -0,0 +1,200 @@
+#include <Bytecode/BytecodeSizeEstimator.hh>
+
+namespace Glyph::Bytecode
+{
+	std::size_t BytecodeSizeEstimator::Estimate(AstNode& node)
+	{
+		BytecodeSizeEstimator estimator;
+		estimator.Visit(node);
+
+		return estimator.GetCount();
+	}
+
+	void BytecodeSizeEstimator::VisitProgramNode(ProgramNode& node)
+	{
+		for(auto& statement : node.GetStatements())
+		{
+			Visit(*statement);
+		}
+
+		// END
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitExpressionNode(ExpressionNode& node) { (void)node; }
+
+	void BytecodeSizeEstimator::VisitStatementNode(StatementNode& node) { (void)node; }
+
+	void BytecodeSizeEstimator::VisitExpressionStatementNode(ExpressionStatementNode& node)
+	{
+		Visit(*node.GetExpression());
+
+		// POP
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitLetDeclarationNode(LetDeclarationNode& node)
+	{
+		Visit(*node.GetExpression());
+
+		// Store
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitPrototypeNode(PrototypeNode& node) { (void)node; }
+
+	void BytecodeSizeEstimator::VisitFunctionDeclarationNode(FunctionDeclarationNode& node)
+	{
+		Visit(*node.GetBlock());
+
+		// Load the function, store it and the implicit return
+		m_Count += 3;
+	}
+
+	void BytecodeSizeEstimator::VisitFunctionCallNode(FunctionCallNode& node)
+	{
+		for(auto& arg : node.GetArgs())
+		{
+			Visit(*arg);
+		}
+
+		// Load the callee, CALL
+		m_Count += 2;
+	}
+
+	void BytecodeSizeEstimator::VisitBlockNode(BlockNode& node)
+	{
+		for(auto& statement : node.GetStatements())
+		{
+			Visit(*statement);
+		}
+
+		// Result and cleanup of the block locals
+		m_Count += 2;
+	}
+
+	void BytecodeSizeEstimator::VisitArithmeticExpressionNode(ArithmeticExpressionNode& node)
+	{
+		Visit(*node.GetLhs());
+		Visit(*node.GetRhs());
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitIfExpressionNode(IfExpressionNode& node)
+	{
+		Visit(*node.GetCondition());
+		Visit(*node.GetTrueBranch());
+		if(auto& falseBranch = node.GetFalseBranch())
+		{
+			Visit(*falseBranch);
+		}
+
+		// Conditional jump over the true branch, jump over the false branch
+		m_Count += 2;
+	}
+
+	void BytecodeSizeEstimator::VisitMatchExpressionNode(MatchExpressionNode& node)
+	{
+		Visit(*node.GetExpression());
+		for(auto& matchCase : node.GetCases())
+		{
+			Visit(*matchCase);
+		}
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitMatchCaseNode(MatchCaseNode& node)
+	{
+		Visit(*node.GetPattern());
+		Visit(*node.GetBlock());
+
+		// Compare, branch and jump to the end
+		m_Count += 3;
+	}
+
+	void BytecodeSizeEstimator::VisitLambdaExpressionNode(LambdaExpressionNode& node)
+	{
+		Visit(*node.GetBlock());
+
+		m_Count += 2;
+	}
+
+	void BytecodeSizeEstimator::VisitIdentifierNode(IdentifierNode& node)
+	{
+		(void)node;
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitLiteralNode(LiteralNode& node)
+	{
+		(void)node;
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitArrayLiteralNode(ArrayLiteralNode& node)
+	{
+		for(auto& element : node.GetElements())
+		{
+			Visit(*element);
+		}
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitDictLiteralNode(DictLiteralNode& node)
+	{
+		for(auto& [key, value] : node.GetEntries())
+		{
+			Visit(*key);
+			Visit(*value);
+		}
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitRecordLiteralNode(RecordLiteralNode& node)
+	{
+		for(auto& [name, value] : node.GetFields())
+		{
+			Visit(*value);
+		}
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitIndexExpressionNode(IndexExpressionNode& node)
+	{
+		Visit(*node.GetObject());
+		Visit(*node.GetKey());
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitFieldExpressionNode(FieldExpressionNode& node)
+	{
+		Visit(*node.GetObject());
+
+		m_Count++;
+	}
+
+	void BytecodeSizeEstimator::VisitOperatorNode(OperatorNode& node) { (void)node; }
+
+	void BytecodeSizeEstimator::VisitArgumentListNode(ArgumentListNode& node)
+	{
+		for(auto& arg : node.GetArgs())
+		{
+			Visit(*arg);
+		}
+	}
+
+	void BytecodeSizeEstimator::VisitReturnStatementNode(ReturnStatementNode& node)
+	{
+		Visit(*node.GetExpression());
+
+		m_Count++;
+	}
+} // namespace Glyph::Bytecode
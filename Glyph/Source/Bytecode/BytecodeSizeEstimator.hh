@@ -0,0 +1,28 @@
+#pragma once
+
+#include <AST/AST.hh>
+#include <Visitors/IASTVisitor.hh>
+
+#include <cstddef>
+
+namespace Glyph::Bytecode
+{
+	/// @brief Cheap pass over the AST guessing how many instructions the compiler will emit for it.
+	/// Used to size the chunk builder up front, it does not need to be exact.
+	class BytecodeSizeEstimator : public IASTVisitor<void>
+	{
+	  public:
+		BytecodeSizeEstimator() = default;
+
+		static std::size_t Estimate(AstNode& node);
+
+#define DEFINE_VISIT_METHOD(name) void Visit##name(name& node) override;
+		AST_NODE_LIST(DEFINE_VISIT_METHOD)
+#undef DEFINE_VISIT_METHOD
+
+		[[nodiscard]] std::size_t GetCount() const { return m_Count; }
+
+	  private:
+		std::size_t m_Count {0};
+	};
+} // namespace Glyph::Bytecode
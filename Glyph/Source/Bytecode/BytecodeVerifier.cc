@@ -0,0 +1,257 @@
+#include <Bytecode/BytecodeVerifier.hh>
+#include <Runtime/FunctionObject.hh>
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Glyph::Bytecode
+{
+	absl::Status BytecodeVerifier::Verify(BytecodeChunk& chunk) { return VerifyChunk(chunk, nullptr); }
+
+	absl::Status BytecodeVerifier::VerifyChunk(BytecodeChunk& chunk, const FunctionObject* function)
+	{
+		if(chunk.m_Verified)
+		{
+			return absl::OkStatus();
+		}
+
+		const auto* bytecode = chunk.Bytecode();
+		const auto count = chunk.InstructionCount();
+		const auto& constants = chunk.GetConstantTable();
+		const auto upvalueCount = function ? function->GetUpvalues().size() : 0;
+
+		auto findFunction = [&](uint32_t index) -> const FunctionObject*
+		{
+			if(index >= constants.GetSize() || !constants.GetValueUnchecked(index).IsObject())
+			{
+				return nullptr;
+			}
+
+			return constants.GetValueUnchecked(index).AsObject()->As<FunctionObject>();
+		};
+
+		if(count == 0)
+		{
+			return absl::InvalidArgumentError("BytecodeVerifier: Empty chunk");
+		}
+
+		// Jumps have to land on the first word of an instruction, never behind a WIDE prefix.
+		std::vector<bool> starts(count, false);
+		std::vector<std::pair<size_t, uint32_t>> jumps;
+
+		for(size_t i = 0; i < count; i++)
+		{
+			starts[i] = true;
+
+			if(static_cast<size_t>(bytecode[i].GetType()) >= OpcodeCount)
+			{
+				return absl::InvalidArgumentError(absl::StrCat("BytecodeVerifier: Unknown opcode at ", i));
+			}
+
+			auto instruction = bytecode[i];
+			uint32_t operand = instruction.GetOperand();
+
+			if(instruction.IsType(Opcode::WIDE))
+			{
+				if(i + 1 == count || bytecode[i + 1].IsType(Opcode::WIDE)
+				   || static_cast<size_t>(bytecode[i + 1].GetType()) >= OpcodeCount)
+				{
+					return absl::InvalidArgumentError(
+						absl::StrCat("BytecodeVerifier: WIDE at ", i, " is not followed by an instruction"));
+				}
+
+				if(operand > (UINT32_MAX >> Instruction::OperandBits))
+				{
+					return absl::InvalidArgumentError(absl::StrCat("BytecodeVerifier: WIDE operand too large at ", i));
+				}
+
+				instruction = bytecode[++i];
+				operand = (operand << Instruction::OperandBits) | instruction.GetOperand();
+			}
+
+			switch(instruction.GetType())
+			{
+				case Opcode::LOAD_CONST:
+					if(operand >= constants.GetSize())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Constant index ", operand, " out of range at ", i));
+					}
+
+					// Without a closure LOAD_UPVALUE in its body would have nothing to read.
+					if(auto* loaded = findFunction(operand); loaded && !loaded->GetUpvalues().empty())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Function with upvalues loaded without CLOSURE at ", i));
+					}
+					break;
+
+				case Opcode::CLOSURE:
+				{
+					auto* closed = findFunction(operand);
+					if(!closed)
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: CLOSURE of a non-function constant at ", i));
+					}
+
+					for(const auto& upvalue : closed->GetUpvalues())
+					{
+						if(upvalue.Index >= (upvalue.IsLocal ? chunk.LocalCount() : upvalueCount))
+						{
+							return absl::InvalidArgumentError(absl::StrCat("BytecodeVerifier: CLOSURE captures ",
+																		   upvalue.IsLocal ? "local " : "upvalue ",
+																		   upvalue.Index, " out of range at ", i));
+						}
+					}
+					break;
+				}
+
+				case Opcode::LOAD_UPVALUE:
+				case Opcode::STORE_UPVALUE:
+					if(operand >= upvalueCount)
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Upvalue ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::LOAD_CALLER_LOCAL:
+				case Opcode::STORE_CALLER_LOCAL:
+					if(!function || operand >= function->GetCallerLocalCount())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Caller local slot ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::CLOSE_UPVALUES:
+					if(operand > chunk.LocalCount())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Local slot ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::LOAD_LOCAL:
+				case Opcode::STORE_LOCAL:
+					if(operand >= chunk.LocalCount())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Local slot ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::LOAD_GLOBAL:
+				case Opcode::STORE_GLOBAL:
+					if(operand >= chunk.GlobalCount())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Global index ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::JUMP:
+				case Opcode::JUMP_IF_FALSE:
+				case Opcode::JUMP_IF_TRUE:
+				case Opcode::JUMP_IF_NOT_LT:
+				case Opcode::JUMP_IF_NOT_GT:
+				case Opcode::JUMP_IF_NOT_LE:
+				case Opcode::JUMP_IF_NOT_GE:
+				case Opcode::JUMP_IF_NOT_EQ:
+				case Opcode::JUMP_IF_NOT_NE: jumps.emplace_back(i, operand); break;
+
+				case Opcode::SWITCH_TABLE:
+					if(operand >= chunk.JumpTables().size())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Jump table ", operand, " out of range at ", i));
+					}
+
+					for(auto target : chunk.JumpTables()[operand].Targets)
+					{
+						jumps.emplace_back(i, target);
+					}
+					jumps.emplace_back(i, chunk.JumpTables()[operand].Default);
+					break;
+
+				case Opcode::SWITCH_SORTED:
+					if(operand >= chunk.SortedJumpTables().size())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Sorted jump table ", operand, " out of range at ", i));
+					}
+
+					if(auto& table = chunk.SortedJumpTables()[operand];
+					   table.Keys.size() != table.Targets.size() || !std::is_sorted(table.Keys.begin(), table.Keys.end()))
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Sorted jump table ", operand, " is malformed at ", i));
+					}
+
+					for(auto target : chunk.SortedJumpTables()[operand].Targets)
+					{
+						jumps.emplace_back(i, target);
+					}
+					jumps.emplace_back(i, chunk.SortedJumpTables()[operand].Default);
+					break;
+
+				case Opcode::RECORD_NEW:
+					if(operand >= chunk.RecordLayouts().size())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Record layout ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::GET_FIELD:
+				case Opcode::SET_FIELD:
+					if(operand >= chunk.FieldCaches().size())
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: Field cache ", operand, " out of range at ", i));
+					}
+					break;
+
+				case Opcode::TAIL_CALL:
+					if(!function)
+					{
+						return absl::InvalidArgumentError(
+							absl::StrCat("BytecodeVerifier: TAIL_CALL outside of a function at ", i));
+					}
+					break;
+
+				default: break;
+			}
+		}
+
+		for(auto [at, target] : jumps)
+		{
+			if(target >= count || !starts[target])
+			{
+				return absl::InvalidArgumentError(
+					absl::StrCat("BytecodeVerifier: Jump target ", target, " is not an instruction at ", at));
+			}
+		}
+
+		auto last = bytecode[count - 1];
+		if(!last.IsType(Opcode::END) && !last.IsType(Opcode::RETURN) && !last.IsType(Opcode::TAIL_CALL))
+		{
+			return absl::InvalidArgumentError("BytecodeVerifier: Chunk does not end in END, RETURN or TAIL_CALL");
+		}
+
+		for(const auto& nested : chunk.Functions())
+		{
+			if(auto status = VerifyChunk(nested->GetChunk(), nested.get()); !status.ok())
+			{
+				return status;
+			}
+		}
+
+		chunk.m_Verified = true;
+
+		return absl::OkStatus();
+	}
+} // namespace Glyph::Bytecode
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Bytecode/BytecodeChunk.hh>
+#include <Runtime/FunctionObject.hh>
+
+#include <absl/status/status.h>
+
+namespace Glyph::Bytecode
+{
+	/// @brief Checks a chunk once before it is run so the VM can skip per-instruction checks.
+	/// A verified chunk only has known opcodes, WIDE prefixes followed by a real instruction, operands in range
+	/// of the tables they index, jumps landing on an instruction, and ends in an instruction that leaves the frame.
+	/// Nested functions are verified too, functions with upvalues are only ever instantiated through CLOSURE.
+	class BytecodeVerifier
+	{
+	  public:
+		static absl::Status Verify(BytecodeChunk& chunk);
+
+	  private:
+		// TAIL_CALL reuses the callee slot below the frame, which only exists in frames entered through CALL.
+		// Upvalue indices are checked against the function the chunk belongs to, null for the top-level chunk.
+		static absl::Status VerifyChunk(BytecodeChunk& chunk, const FunctionObject* function);
+	};
+} // namespace Glyph::Bytecode
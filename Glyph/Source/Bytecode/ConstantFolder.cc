@@ -0,0 +1,347 @@
+#include <Bytecode/ConstantFolder.hh>
+
+#include <vector>
+
+namespace Glyph::Bytecode
+{
+	const Value* ConstantFolding::Find(const AstNode& node) const
+	{
+		auto it = m_Values.find(&node);
+		if(it == m_Values.end())
+		{
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
+	std::optional<std::size_t> ConstantFolding::FindTakenCase(const MatchExpressionNode& node) const
+	{
+		auto it = m_TakenCases.find(&node);
+		if(it == m_TakenCases.end())
+		{
+			return std::nullopt;
+		}
+
+		return it->second;
+	}
+
+	ConstantFolder::ConstantFolder(ConstantFolding& folding)
+		: m_Folding(folding)
+	{
+	}
+
+	void ConstantFolder::Fold(AstNode& node, ConstantFolding& folding)
+	{
+		ConstantFolder folder(folding);
+
+		folder.Visit(node);
+	}
+
+	std::optional<Value> ConstantFolder::Visit(AstNode& node)
+	{
+#define VISIT_CASE(name)                                                                                               \
+	case NodeType::name: value = Visit##name(dynamic_cast<name&>(node)); break;
+
+		std::optional<Value> value;
+		switch(node.GetType())
+		{
+			AST_NODE_LIST(VISIT_CASE)
+		}
+
+#undef VISIT_CASE
+
+		if(value)
+		{
+			m_Folding.m_Values.emplace(&node, *value);
+		}
+
+		return value;
+	}
+
+	std::optional<Value> ConstantFolder::Evaluate(OperatorNode::Operator op, const Value& lhs, const Value& rhs)
+	{
+		using enum OperatorNode::Operator;
+
+		switch(op)
+		{
+			case Equal: return Value(lhs == rhs);
+			case NotEqual: return Value(!(lhs == rhs));
+			case And:
+			case Or:
+			case In:
+			case Assign: return std::nullopt;
+			default: break;
+		}
+
+		if(!lhs.IsNumber() || !rhs.IsNumber())
+		{
+			return std::nullopt;
+		}
+
+		auto a = lhs.AsNumber();
+		auto b = rhs.AsNumber();
+
+		switch(op)
+		{
+			case Plus: return Value(a + b);
+			case Minus: return Value(a - b);
+			case Star: return Value(a * b);
+			case Slash: return Value(a / b);
+			case Less: return Value(a < b);
+			case Greater: return Value(a > b);
+			case LessEqual: return Value(a <= b);
+			case GreaterEqual: return Value(a >= b);
+			default: return std::nullopt;
+		}
+	}
+
+	std::optional<Value> ConstantFolder::VisitProgramNode(ProgramNode& node)
+	{
+		for(auto& statement : node.GetStatements())
+		{
+			Visit(*statement);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitExpressionNode(ExpressionNode& node) { return std::nullopt; }
+
+	std::optional<Value> ConstantFolder::VisitStatementNode(StatementNode& node) { return std::nullopt; }
+
+	std::optional<Value> ConstantFolder::VisitExpressionStatementNode(ExpressionStatementNode& node)
+	{
+		Visit(*node.GetExpression());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitLetDeclarationNode(LetDeclarationNode& node)
+	{
+		Visit(*node.GetExpression());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitPrototypeNode(PrototypeNode& node) { return std::nullopt; }
+
+	std::optional<Value> ConstantFolder::VisitFunctionDeclarationNode(FunctionDeclarationNode& node)
+	{
+		Visit(*node.GetBlock());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitFunctionCallNode(FunctionCallNode& node)
+	{
+		for(auto& arg : node.GetArgs())
+		{
+			Visit(*arg);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitBlockNode(BlockNode& node)
+	{
+		std::optional<Value> value = Value();
+		bool returned = false;
+
+		for(auto& statement : node.GetStatements())
+		{
+			auto result = Visit(*statement);
+
+			// Only a block that does nothing but return a constant is constant itself.
+			if(!returned)
+			{
+				auto* ret = statement->As<ReturnStatementNode>();
+				value = ret ? result : std::nullopt;
+				returned = true;
+			}
+		}
+
+		return value;
+	}
+
+	std::optional<Value> ConstantFolder::VisitArithmeticExpressionNode(ArithmeticExpressionNode& node)
+	{
+		auto lhs = Visit(*node.GetLhs());
+		auto rhs = Visit(*node.GetRhs());
+
+		// Short-circuiting operators evaluate to whichever operand decides the result.
+		if(auto op = node.GetOp()->GetOp(); op == OperatorNode::Operator::And || op == OperatorNode::Operator::Or)
+		{
+			if(!lhs)
+			{
+				return std::nullopt;
+			}
+
+			bool decided = op == OperatorNode::Operator::And ? !lhs->IsTruthy() : lhs->IsTruthy();
+
+			return decided ? lhs : rhs;
+		}
+
+		if(!lhs || !rhs)
+		{
+			return std::nullopt;
+		}
+
+		return Evaluate(node.GetOp()->GetOp(), *lhs, *rhs);
+	}
+
+	std::optional<Value> ConstantFolder::VisitIfExpressionNode(IfExpressionNode& node)
+	{
+		auto condition = Visit(*node.GetCondition());
+		auto trueBranch = Visit(*node.GetTrueBranch());
+		std::optional<Value> falseBranch = Value();
+		if(auto& branch = node.GetFalseBranch())
+		{
+			falseBranch = Visit(*branch);
+		}
+
+		if(!condition)
+		{
+			return std::nullopt;
+		}
+
+		return condition->IsTruthy() ? trueBranch : falseBranch;
+	}
+
+	std::optional<Value> ConstantFolder::VisitMatchExpressionNode(MatchExpressionNode& node)
+	{
+		auto scrutinee = Visit(*node.GetExpression());
+
+		auto& cases = node.GetCases();
+		std::optional<std::size_t> taken;
+		std::vector<std::optional<Value>> results;
+		results.reserve(cases.size());
+
+		bool resolvable = scrutinee.has_value();
+		for(std::size_t i = 0; i < cases.size(); i++)
+		{
+			auto pattern = Visit(*cases[i]->GetPattern());
+			results.push_back(Visit(*cases[i]->GetBlock()));
+
+			// A pattern only known at runtime could match before any later constant one does.
+			if(!resolvable || taken)
+			{
+				continue;
+			}
+
+			if(!pattern)
+			{
+				resolvable = false;
+			}
+			else if(*pattern == *scrutinee)
+			{
+				taken = i;
+			}
+		}
+
+		if(!resolvable)
+		{
+			return std::nullopt;
+		}
+
+		m_Folding.m_TakenCases[&node] = taken.value_or(cases.size());
+
+		if(!taken)
+		{
+			return Value();
+		}
+
+		return results[*taken];
+	}
+
+	std::optional<Value> ConstantFolder::VisitMatchCaseNode(MatchCaseNode& node)
+	{
+		Visit(*node.GetPattern());
+		Visit(*node.GetBlock());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitLambdaExpressionNode(LambdaExpressionNode& node)
+	{
+		Visit(*node.GetBlock());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitIdentifierNode(IdentifierNode& node) { return std::nullopt; }
+
+	std::optional<Value> ConstantFolder::VisitLiteralNode(LiteralNode& node)
+	{
+		// Strings have no Value before the compiler interns them.
+		if(node.IsString())
+		{
+			return std::nullopt;
+		}
+
+		return node.GetValue();
+	}
+
+	std::optional<Value> ConstantFolder::VisitArrayLiteralNode(ArrayLiteralNode& node)
+	{
+		for(auto& element : node.GetElements())
+		{
+			Visit(*element);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitDictLiteralNode(DictLiteralNode& node)
+	{
+		for(auto& [key, value] : node.GetEntries())
+		{
+			Visit(*key);
+			Visit(*value);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitRecordLiteralNode(RecordLiteralNode& node)
+	{
+		for(auto& [name, value] : node.GetFields())
+		{
+			Visit(*value);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitIndexExpressionNode(IndexExpressionNode& node)
+	{
+		Visit(*node.GetObject());
+		Visit(*node.GetKey());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitFieldExpressionNode(FieldExpressionNode& node)
+	{
+		Visit(*node.GetObject());
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitOperatorNode(OperatorNode& node) { return std::nullopt; }
+
+	std::optional<Value> ConstantFolder::VisitArgumentListNode(ArgumentListNode& node)
+	{
+		for(auto& arg : node.GetArgs())
+		{
+			Visit(*arg);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<Value> ConstantFolder::VisitReturnStatementNode(ReturnStatementNode& node)
+	{
+		return Visit(*node.GetExpression());
+	}
+} // namespace Glyph::Bytecode
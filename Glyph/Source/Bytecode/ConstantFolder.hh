@@ -0,0 +1,54 @@
+#pragma once
+
+#include <AST/AST.hh>
+#include <Runtime/Value.hh>
+#include <Visitors/IASTVisitor.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstddef>
+#include <optional>
+
+namespace Glyph::Bytecode
+{
+	/// @brief Expressions of a program whose value is known at compile time, produced by ConstantFolder.
+	class ConstantFolding
+	{
+	  public:
+		/// @brief Value of an expression made only of literals, or nullptr when it has to be evaluated at runtime.
+		[[nodiscard]] const Value* Find(const AstNode& node) const;
+
+		/// @brief Arm a match on a constant scrutinee always takes, the number of cases when none matches.
+		/// Empty when the arm can only be picked at runtime.
+		[[nodiscard]] std::optional<std::size_t> FindTakenCase(const MatchExpressionNode& node) const;
+
+	  private:
+		friend class ConstantFolder;
+
+		absl::flat_hash_map<const AstNode*, Value> m_Values;
+		absl::flat_hash_map<const AstNode*, std::size_t> m_TakenCases;
+	};
+
+	/// @brief Evaluates constant subtrees once, bottom up, so the compiler emits a single LOAD_CONST for them.
+	/// Arithmetic is done on doubles exactly like the VM does it, operands of the wrong type are left for the VM
+	/// to report at runtime.
+	class ConstantFolder : public IASTVisitor<std::optional<Value>>
+	{
+	  public:
+		static void Fold(AstNode& node, ConstantFolding& folding);
+
+#define DEFINE_VISIT_METHOD(name) std::optional<Value> Visit##name(name& node) override;
+		AST_NODE_LIST(DEFINE_VISIT_METHOD)
+#undef DEFINE_VISIT_METHOD
+
+		std::optional<Value> Visit(AstNode& node) override;
+
+	  private:
+		explicit ConstantFolder(ConstantFolding& folding);
+
+		static std::optional<Value> Evaluate(OperatorNode::Operator op, const Value& lhs, const Value& rhs);
+
+	  private:
+		ConstantFolding& m_Folding;
+	};
+} // namespace Glyph::Bytecode
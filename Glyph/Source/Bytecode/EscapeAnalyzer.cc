@@ -0,0 +1,226 @@
+#include <Bytecode/EscapeAnalyzer.hh>
+
+#include <algorithm>
+
+namespace Glyph::Bytecode
+{
+	bool EscapeAnalysis::BorrowsCallerFrame(const AstNode& function) const
+	{
+		return m_FrameFunctions.contains(&function);
+	}
+
+	bool EscapeAnalysis::CallsFrameFunction(const FunctionCallNode& call) const
+	{
+		return m_FrameFunctionCalls.contains(&call);
+	}
+
+	EscapeAnalyzer::EscapeAnalyzer(const ScopeResolution& resolution, EscapeAnalysis& analysis)
+		: m_Resolution(resolution)
+		, m_Analysis(analysis)
+	{
+	}
+
+	void EscapeAnalyzer::Analyze(ProgramNode& program, const ScopeResolution& resolution, EscapeAnalysis& analysis)
+	{
+		EscapeAnalyzer analyzer(resolution, analysis);
+
+		analyzer.Visit(program);
+
+		for(auto* function : analyzer.m_Candidates)
+		{
+			if(analyzer.m_Escaped.contains(function) || analyzer.m_Forwarding.contains(function))
+			{
+				continue;
+			}
+
+			// The caller frame only holds what the defining frame declared itself, anything captured from further
+			// out needs an upvalue.
+			auto& upvalues = resolution.GetUpvalues(*function);
+			if(upvalues.empty()
+			   || !std::all_of(upvalues.begin(), upvalues.end(), [](const auto& upvalue) { return upvalue.IsLocal; }))
+			{
+				continue;
+			}
+
+			analysis.m_FrameFunctions.insert(function);
+			for(auto* call : analyzer.m_Calls[function])
+			{
+				analysis.m_FrameFunctionCalls.insert(call);
+			}
+		}
+	}
+
+	void EscapeAnalyzer::VisitFunction(const AstNode& node, BlockNode& body)
+	{
+		// Upvalues forwarded from the enclosing function have to exist there as real upvalues.
+		auto& upvalues = m_Resolution.GetUpvalues(node);
+		if(!m_Functions.empty()
+		   && std::any_of(upvalues.begin(), upvalues.end(), [](const auto& upvalue) { return !upvalue.IsLocal; }))
+		{
+			m_Forwarding.insert(m_Functions.back());
+		}
+
+		m_Functions.push_back(&node);
+		Visit(body);
+		m_Functions.pop_back();
+	}
+
+	void EscapeAnalyzer::VisitProgramNode(ProgramNode& node)
+	{
+		m_Functions.push_back(&node);
+		for(auto& statement : node.GetStatements())
+		{
+			Visit(*statement);
+		}
+		m_Functions.pop_back();
+	}
+
+	void EscapeAnalyzer::VisitExpressionNode(ExpressionNode& node) {}
+
+	void EscapeAnalyzer::VisitStatementNode(StatementNode& node) {}
+
+	void EscapeAnalyzer::VisitExpressionStatementNode(ExpressionStatementNode& node) { Visit(*node.GetExpression()); }
+
+	void EscapeAnalyzer::VisitLetDeclarationNode(LetDeclarationNode& node) { Visit(*node.GetExpression()); }
+
+	void EscapeAnalyzer::VisitPrototypeNode(PrototypeNode& node) {}
+
+	void EscapeAnalyzer::VisitFunctionDeclarationNode(FunctionDeclarationNode& node)
+	{
+		// Top-level functions are globals, anyone can call them.
+		if(auto* slot = m_Resolution.Find(node); slot && slot->Kind == VariableSlot::Kind::Local)
+		{
+			m_Candidates.push_back(&node);
+		}
+
+		VisitFunction(node, *node.GetBlock());
+	}
+
+	void EscapeAnalyzer::VisitFunctionCallNode(FunctionCallNode& node)
+	{
+		// Calling by name from the defining frame is the one use that keeps the function in place.
+		auto& callee = *node.GetName();
+		auto* declaration = m_Resolution.FindDeclaration(callee);
+		auto* slot = m_Resolution.Find(callee);
+		if(declaration && slot && slot->Kind == VariableSlot::Kind::Local)
+		{
+			m_Calls[declaration].push_back(&node);
+		}
+		else
+		{
+			Visit(callee);
+		}
+
+		for(auto& arg : node.GetArgs())
+		{
+			Visit(*arg);
+		}
+	}
+
+	void EscapeAnalyzer::VisitBlockNode(BlockNode& node)
+	{
+		for(auto& statement : node.GetStatements())
+		{
+			Visit(*statement);
+		}
+	}
+
+	void EscapeAnalyzer::VisitArithmeticExpressionNode(ArithmeticExpressionNode& node)
+	{
+		// Assigning to the name replaces the function, it doesn't hand it anywhere. Storing into a dict or a record
+		// reads the container and the key like any other use.
+		if(node.GetOp()->GetOp() != OperatorNode::Operator::Assign || node.GetLhs()->Is<IndexExpressionNode>()
+		   || node.GetLhs()->Is<FieldExpressionNode>())
+		{
+			Visit(*node.GetLhs());
+		}
+
+		Visit(*node.GetRhs());
+	}
+
+	void EscapeAnalyzer::VisitIfExpressionNode(IfExpressionNode& node)
+	{
+		Visit(*node.GetCondition());
+		Visit(*node.GetTrueBranch());
+		if(auto& falseBranch = node.GetFalseBranch())
+		{
+			Visit(*falseBranch);
+		}
+	}
+
+	void EscapeAnalyzer::VisitMatchExpressionNode(MatchExpressionNode& node)
+	{
+		Visit(*node.GetExpression());
+		for(auto& matchCase : node.GetCases())
+		{
+			Visit(*matchCase);
+		}
+	}
+
+	void EscapeAnalyzer::VisitMatchCaseNode(MatchCaseNode& node)
+	{
+		Visit(*node.GetPattern());
+		Visit(*node.GetBlock());
+	}
+
+	void EscapeAnalyzer::VisitLambdaExpressionNode(LambdaExpressionNode& node)
+	{
+		VisitFunction(node, *node.GetBlock());
+	}
+
+	void EscapeAnalyzer::VisitIdentifierNode(IdentifierNode& node)
+	{
+		// Any use besides a direct call passes the function on as a value.
+		if(auto* declaration = m_Resolution.FindDeclaration(node))
+		{
+			m_Escaped.insert(declaration);
+		}
+	}
+
+	void EscapeAnalyzer::VisitLiteralNode(LiteralNode& node) {}
+
+	void EscapeAnalyzer::VisitArrayLiteralNode(ArrayLiteralNode& node)
+	{
+		for(auto& element : node.GetElements())
+		{
+			Visit(*element);
+		}
+	}
+
+	void EscapeAnalyzer::VisitDictLiteralNode(DictLiteralNode& node)
+	{
+		for(auto& [key, value] : node.GetEntries())
+		{
+			Visit(*key);
+			Visit(*value);
+		}
+	}
+
+	void EscapeAnalyzer::VisitRecordLiteralNode(RecordLiteralNode& node)
+	{
+		for(auto& [name, value] : node.GetFields())
+		{
+			Visit(*value);
+		}
+	}
+
+	void EscapeAnalyzer::VisitIndexExpressionNode(IndexExpressionNode& node)
+	{
+		Visit(*node.GetObject());
+		Visit(*node.GetKey());
+	}
+
+	void EscapeAnalyzer::VisitFieldExpressionNode(FieldExpressionNode& node) { Visit(*node.GetObject()); }
+
+	void EscapeAnalyzer::VisitOperatorNode(OperatorNode& node) {}
+
+	void EscapeAnalyzer::VisitArgumentListNode(ArgumentListNode& node)
+	{
+		for(auto& arg : node.GetArgs())
+		{
+			Visit(*arg);
+		}
+	}
+
+	void EscapeAnalyzer::VisitReturnStatementNode(ReturnStatementNode& node) { Visit(*node.GetExpression()); }
+} // namespace Glyph::Bytecode
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <AST/AST.hh>
+#include <Bytecode/ScopeResolver.hh>
+#include <Visitors/IASTVisitor.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Glyph::Bytecode
+{
+	/// @brief Local functions that never outlive the frame defining them, produced by EscapeAnalyzer.
+	class EscapeAnalysis
+	{
+	  public:
+		/// @brief Whether a function runs on its caller's locals instead of a closure. Such a function is only ever
+		/// called directly by the frame that defined it, so no closure or upvalue is allocated for it.
+		[[nodiscard]] bool BorrowsCallerFrame(const AstNode& function) const;
+
+		/// @brief Whether a call targets a function borrowing the caller frame. Such a call can't be a tail call, the
+		/// frame it borrows would be gone.
+		[[nodiscard]] bool CallsFrameFunction(const FunctionCallNode& call) const;
+
+	  private:
+		friend class EscapeAnalyzer;
+
+		absl::flat_hash_set<const AstNode*> m_FrameFunctions;
+		absl::flat_hash_set<const AstNode*> m_FrameFunctionCalls;
+	};
+
+	/// @brief Finds capturing functions declared in a block (`let f = (x) -> { ... };`) whose every use is a direct
+	/// call from the same frame. Passing, returning, assigning or capturing the name, calling itself included, lets
+	/// the function escape and it stays a closure. Functions capturing nothing are plain constants already.
+	class EscapeAnalyzer : public IASTVisitor<void>
+	{
+	  public:
+		static void Analyze(ProgramNode& program, const ScopeResolution& resolution, EscapeAnalysis& analysis);
+
+#define DEFINE_VISIT_METHOD(name) void Visit##name(name& node) override;
+		AST_NODE_LIST(DEFINE_VISIT_METHOD)
+#undef DEFINE_VISIT_METHOD
+
+		using IASTVisitor<void>::Visit;
+
+	  private:
+		EscapeAnalyzer(const ScopeResolution& resolution, EscapeAnalysis& analysis);
+
+		void VisitFunction(const AstNode& node, BlockNode& body);
+
+	  private:
+		const ScopeResolution& m_Resolution;
+		EscapeAnalysis& m_Analysis;
+
+		/// @brief Local function declarations, with the calls made through them.
+		std::vector<const FunctionDeclarationNode*> m_Candidates;
+		absl::flat_hash_map<const AstNode*, std::vector<const FunctionCallNode*>> m_Calls;
+		absl::flat_hash_set<const AstNode*> m_Escaped;
+
+		/// @brief Functions whose upvalues are captured again by a function nested in them, they need real ones.
+		absl::flat_hash_set<const AstNode*> m_Forwarding;
+		std::vector<const AstNode*> m_Functions;
+	};
+} // namespace Glyph::Bytecode
@@ -0,0 +1,149 @@
+#include <Bytecode/Natives.hh>
+#include <Bytecode/VM.hh>
+#include <Macros.hh>
+#include <Runtime/DictObject.hh>
+#include <Runtime/Float64ArrayObject.hh>
+#include <Runtime/RopeObject.hh>
+#include <Runtime/VectorKernels.hh>
+
+#include <absl/strings/str_cat.h>
+
+#include <cmath>
+#include <initializer_list>
+
+namespace
+{
+	using Glyph::Float64ArrayObject;
+	using Glyph::Value;
+	using Glyph::Bytecode::VM;
+
+	absl::StatusOr<Float64ArrayObject*> GetArray(const Value& value, const char* native)
+	{
+		auto* object = value.AsObject();
+		auto* array = object ? object->As<Float64ArrayObject>() : nullptr;
+		if(!array)
+		{
+			return absl::InvalidArgumentError(absl::StrCat("VM: ", native, " expects arrays"));
+		}
+
+		return array;
+	}
+
+	absl::Status CheckSameLength(std::initializer_list<const Float64ArrayObject*> arrays, const char* native)
+	{
+		for(const auto* array : arrays)
+		{
+			if(array->GetLength() != (*arrays.begin())->GetLength())
+			{
+				return absl::InvalidArgumentError(absl::StrCat("VM: ", native, " expects arrays of the same length"));
+			}
+		}
+
+		return absl::OkStatus();
+	}
+
+	absl::StatusOr<Value> Array(VM& vm, const Value* args)
+	{
+		auto length = args[0].IsNumber() ? args[0].AsNumber() : -1.0;
+		if(length < 0 || length != std::floor(length))
+		{
+			return absl::InvalidArgumentError("VM: array expects a length");
+		}
+
+		return Value(TRY_RET(vm.NewFloat64Array(static_cast<std::size_t>(length))));
+	}
+
+	absl::StatusOr<Value> Len(VM& vm, const Value* args)
+	{
+		if(auto* object = args[0].AsObject())
+		{
+			switch(object->GetType())
+			{
+				case Glyph::ObjectType::Float64Array:
+					return Value(static_cast<double>(static_cast<Float64ArrayObject*>(object)->GetLength()));
+				case Glyph::ObjectType::String:
+				case Glyph::ObjectType::Rope: return Value(static_cast<double>(Glyph::RopeObject::LengthOf(object)));
+				case Glyph::ObjectType::Dict:
+					return Value(static_cast<double>(static_cast<Glyph::DictObject*>(object)->GetSize()));
+				default: break;
+			}
+		}
+
+		return absl::InvalidArgumentError("VM: len expects an array, a string or a dict");
+	}
+
+	template<auto Glyph::VectorKernels::*Kernel> absl::StatusOr<Value> ElementWise(VM& vm, const Value* args)
+	{
+		constexpr const char* name = Kernel == &Glyph::VectorKernels::Add ? "add" : "mul";
+
+		auto* a = TRY_RET(GetArray(args[0], name));
+		auto* b = TRY_RET(GetArray(args[1], name));
+		TRY(CheckSameLength({a, b}, name));
+
+		// The arguments are still on the stack, they survive a collection while allocating the result.
+		auto* result = TRY_RET(vm.NewFloat64Array(a->GetLength()));
+		(Glyph::GetVectorKernels().*Kernel)(result->GetData(), a->GetData(), b->GetData(), a->GetLength());
+
+		return Value(result);
+	}
+
+	absl::StatusOr<Value> Fma(VM& vm, const Value* args)
+	{
+		auto* a = TRY_RET(GetArray(args[0], "fma"));
+		auto* b = TRY_RET(GetArray(args[1], "fma"));
+		auto* c = TRY_RET(GetArray(args[2], "fma"));
+		TRY(CheckSameLength({a, b, c}, "fma"));
+
+		auto* result = TRY_RET(vm.NewFloat64Array(a->GetLength()));
+		Glyph::GetVectorKernels().Fma(result->GetData(), a->GetData(), b->GetData(), c->GetData(), a->GetLength());
+
+		return Value(result);
+	}
+
+	absl::StatusOr<Value> Sum(VM& vm, const Value* args)
+	{
+		auto* a = TRY_RET(GetArray(args[0], "sum"));
+
+		return Value(Glyph::GetVectorKernels().Sum(a->GetData(), a->GetLength()));
+	}
+
+	// Null for an empty array, which has neither.
+	template<auto Glyph::VectorKernels::*Kernel> absl::StatusOr<Value> Extremum(VM& vm, const Value* args)
+	{
+		constexpr const char* name = Kernel == &Glyph::VectorKernels::Min ? "min" : "max";
+
+		auto* a = TRY_RET(GetArray(args[0], name));
+		if(a->GetLength() == 0)
+		{
+			return Value();
+		}
+
+		return Value((Glyph::GetVectorKernels().*Kernel)(a->GetData(), a->GetLength()));
+	}
+
+	absl::StatusOr<Value> Dot(VM& vm, const Value* args)
+	{
+		auto* a = TRY_RET(GetArray(args[0], "dot"));
+		auto* b = TRY_RET(GetArray(args[1], "dot"));
+		TRY(CheckSameLength({a, b}, "dot"));
+
+		return Value(Glyph::GetVectorKernels().Dot(a->GetData(), b->GetData(), a->GetLength()));
+	}
+
+	constexpr Glyph::Bytecode::NativeDefinition Natives[] = {
+		{"array", 1, Array},
+		{"len", 1, Len},
+		{"add", 2, ElementWise<&Glyph::VectorKernels::Add>},
+		{"mul", 2, ElementWise<&Glyph::VectorKernels::Mul>},
+		{"fma", 3, Fma},
+		{"sum", 1, Sum},
+		{"min", 1, Extremum<&Glyph::VectorKernels::Min>},
+		{"max", 1, Extremum<&Glyph::VectorKernels::Max>},
+		{"dot", 2, Dot},
+	};
+} // namespace
+
+namespace Glyph::Bytecode
+{
+	std::span<const NativeDefinition> GetNatives() { return Natives; }
+} // namespace Glyph::Bytecode
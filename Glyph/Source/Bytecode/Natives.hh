@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Runtime/NativeObject.hh>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Glyph::Bytecode
+{
+	struct NativeDefinition
+	{
+		std::string_view Name;
+		uint32_t Arity;
+		NativeFunction Function;
+	};
+
+	/// @brief Every built-in, in the order of the global slots they take. ScopeResolver declares them as the first
+	/// globals of each program and the VM stores them there before running it, so a top level let of the same name
+	/// takes the slot over.
+	std::span<const NativeDefinition> GetNatives();
+} // namespace Glyph::Bytecode
@@ -0,0 +1,473 @@
+#include <Bytecode/Natives.hh>
+#include <Bytecode/ScopeResolver.hh>
+#include <Macros.hh>
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+
+namespace Glyph::Bytecode
+{
+	const VariableSlot* ScopeResolution::Find(const AstNode& node) const
+	{
+		auto it = m_Slots.find(&node);
+		if(it == m_Slots.end())
+		{
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
+	const AstNode* ScopeResolution::FindDeclaration(const AstNode& node) const
+	{
+		auto it = m_Declarations.find(&node);
+		if(it == m_Declarations.end())
+		{
+			return nullptr;
+		}
+
+		return it->second;
+	}
+
+	uint32_t ScopeResolution::GetLocalCount(const AstNode& frame) const
+	{
+		auto it = m_LocalCounts.find(&frame);
+		if(it == m_LocalCounts.end())
+		{
+			return 0;
+		}
+
+		return it->second;
+	}
+
+	const std::vector<UpvalueDescriptor>& ScopeResolution::GetUpvalues(const AstNode& frame) const
+	{
+		static const std::vector<UpvalueDescriptor> none;
+
+		auto it = m_Upvalues.find(&frame);
+		if(it == m_Upvalues.end())
+		{
+			return none;
+		}
+
+		return it->second;
+	}
+
+	std::optional<uint32_t> ScopeResolution::FindClosingSlot(const BlockNode& block) const
+	{
+		auto it = m_ClosingSlots.find(&block);
+		if(it == m_ClosingSlots.end())
+		{
+			return std::nullopt;
+		}
+
+		return it->second;
+	}
+
+	ScopeResolver::ScopeResolver(ScopeResolution& resolution)
+		: m_Resolution(resolution)
+	{
+	}
+
+	BytecodeStepResult ScopeResolver::Resolve(ProgramNode& program, ScopeResolution& resolution)
+	{
+		ScopeResolver resolver(resolution);
+
+		return resolver.Visit(program);
+	}
+
+	BytecodeStepResult ScopeResolver::Visit(AstNode& node)
+	{
+#define VISIT_CASE(name)                                                                                               \
+	case NodeType::name: return Visit##name(dynamic_cast<name&>(node));
+
+		switch(node.GetType())
+		{
+			AST_NODE_LIST(VISIT_CASE)
+		}
+
+#undef VISIT_CASE
+
+		return {};
+	}
+
+	void ScopeResolver::BeginFrame(const AstNode& node, const std::vector<std::string>& params)
+	{
+		m_Frames.push_back({&node, {}, {}, 0, 0});
+		BeginScope(node);
+
+		for(auto& param : params)
+		{
+			DeclareLocal(param, nullptr);
+		}
+	}
+
+	void ScopeResolver::EndFrame()
+	{
+		EndScope();
+
+		auto& frame = m_Frames.back();
+		m_Resolution.m_LocalCounts[frame.Node] = frame.MaxSlots;
+
+		if(!frame.Upvalues.empty())
+		{
+			m_Resolution.m_Upvalues[frame.Node] = std::move(frame.Upvalues);
+		}
+
+		m_Frames.pop_back();
+	}
+
+	void ScopeResolver::BeginScope(const AstNode& node)
+	{
+		auto& frame = m_Frames.back();
+		frame.Scopes.push_back({&node, {}, frame.NextSlot, false});
+	}
+
+	void ScopeResolver::EndScope()
+	{
+		// Slots of a finished scope are free to be reused by its siblings, so captured ones have to be closed first.
+		// The outermost scope of a frame is closed by returning from it.
+		auto& frame = m_Frames.back();
+		auto& scope = frame.Scopes.back();
+		if(scope.Captured && frame.Scopes.size() > 1)
+		{
+			m_Resolution.m_ClosingSlots[scope.Node] = scope.FirstSlot;
+		}
+
+		frame.NextSlot = scope.FirstSlot;
+		frame.Scopes.pop_back();
+	}
+
+	uint32_t ScopeResolver::AddUpvalue(Frame& frame, UpvalueDescriptor upvalue)
+	{
+		// Every use of the same variable in a function shares one upvalue.
+		auto it = std::find(frame.Upvalues.begin(), frame.Upvalues.end(), upvalue);
+		if(it != frame.Upvalues.end())
+		{
+			return it - frame.Upvalues.begin();
+		}
+
+		frame.Upvalues.push_back(upvalue);
+
+		return frame.Upvalues.size() - 1;
+	}
+
+	uint32_t ScopeResolver::DeclareLocal(const std::string& name, const AstNode* declaration)
+	{
+		auto& frame = m_Frames.back();
+		auto slot = frame.NextSlot++;
+		frame.MaxSlots = std::max(frame.MaxSlots, frame.NextSlot);
+
+		frame.Scopes.back().Names.push_back({name, slot, declaration});
+
+		return slot;
+	}
+
+	BytecodeStepResult ScopeResolver::ResolveUse(IdentifierNode& node)
+	{
+		auto& name = node.GetName();
+
+		for(auto frame = m_Frames.rbegin(); frame != m_Frames.rend(); ++frame)
+		{
+			for(auto scope = frame->Scopes.rbegin(); scope != frame->Scopes.rend(); ++scope)
+			{
+				// Later declarations shadow earlier ones in the same scope.
+				auto it = std::find_if(scope->Names.rbegin(), scope->Names.rend(),
+									   [&](const auto& entry) { return entry.Name == name; });
+				if(it == scope->Names.rend())
+				{
+					continue;
+				}
+
+				if(it->Declaration)
+				{
+					m_Resolution.m_Declarations[&node] = it->Declaration;
+				}
+
+				if(frame == m_Frames.rbegin())
+				{
+					m_Resolution.m_Slots[&node] = {VariableSlot::Kind::Local, it->Slot};
+
+					return {};
+				}
+
+				// Thread the variable through every function between its declaration and this use, the function
+				// directly inside the declaring one captures the local and each one further in its parent's upvalue.
+				scope->Captured = true;
+
+				UpvalueDescriptor upvalue {true, it->Slot};
+				for(auto inner = frame.base(); inner != m_Frames.end(); ++inner)
+				{
+					upvalue = {false, AddUpvalue(*inner, upvalue)};
+				}
+
+				m_Resolution.m_Slots[&node] = {VariableSlot::Kind::Upvalue, upvalue.Index};
+
+				return {};
+			}
+		}
+
+		if(auto it = m_Globals.find(name); it != m_Globals.end())
+		{
+			m_Resolution.m_Slots[&node] = {VariableSlot::Kind::Global, it->second};
+
+			return {};
+		}
+
+		return BytecodeStepResult(&node, absl::NotFoundError(absl::StrCat("Undefined variable '", name, "'")));
+	}
+
+	BytecodeStepResult
+	ScopeResolver::ResolveFunction(const AstNode& node, const std::vector<std::string>& params, BlockNode& body)
+	{
+		BeginFrame(node, params);
+
+		for(auto& statement : body.GetStatements())
+		{
+			TRY(Visit(*statement));
+		}
+
+		EndFrame();
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitProgramNode(ProgramNode& node)
+	{
+		// Built-ins come first, the VM stores them in these slots before the program runs.
+		for(const auto& native : GetNatives())
+		{
+			m_Globals[std::string(native.Name)] = m_Resolution.m_GlobalNames.size();
+			m_Resolution.m_GlobalNames.emplace_back(native.Name);
+		}
+
+		// Globals are hoisted so functions can refer to ones declared further down.
+		for(auto& statement : node.GetStatements())
+		{
+			const std::string* name = nullptr;
+			if(auto* let = statement->As<LetDeclarationNode>())
+			{
+				name = &let->GetIdentifier()->GetName();
+			}
+			else if(auto* function = statement->As<FunctionDeclarationNode>())
+			{
+				name = &function->GetPrototype()->GetName()->GetName();
+			}
+
+			if(name && !m_Globals.contains(*name))
+			{
+				m_Globals[*name] = m_Resolution.m_GlobalNames.size();
+				m_Resolution.m_GlobalNames.push_back(*name);
+			}
+		}
+
+		BeginFrame(node, {});
+
+		for(auto& statement : node.GetStatements())
+		{
+			if(auto* let = statement->As<LetDeclarationNode>())
+			{
+				TRY(Visit(*let->GetExpression()));
+
+				m_Resolution.m_Slots[let] = {VariableSlot::Kind::Global, m_Globals[let->GetIdentifier()->GetName()]};
+				continue;
+			}
+
+			if(auto* function = statement->As<FunctionDeclarationNode>())
+			{
+				m_Resolution.m_Slots[function]
+					= {VariableSlot::Kind::Global, m_Globals[function->GetPrototype()->GetName()->GetName()]};
+
+				TRY(ResolveFunction(*function, function->GetPrototype()->GetArgs(), *function->GetBlock()));
+				continue;
+			}
+
+			TRY(Visit(*statement));
+		}
+
+		EndFrame();
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitExpressionNode(ExpressionNode& node) { return {}; }
+
+	BytecodeStepResult ScopeResolver::VisitStatementNode(StatementNode& node) { return {}; }
+
+	BytecodeStepResult ScopeResolver::VisitExpressionStatementNode(ExpressionStatementNode& node)
+	{
+		return Visit(*node.GetExpression());
+	}
+
+	BytecodeStepResult ScopeResolver::VisitLetDeclarationNode(LetDeclarationNode& node)
+	{
+		// The initializer still sees the previous binding of the name.
+		TRY(Visit(*node.GetExpression()));
+
+		m_Resolution.m_Slots[&node] = {VariableSlot::Kind::Local, DeclareLocal(node.GetIdentifier()->GetName(), &node)};
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitPrototypeNode(PrototypeNode& node) { return {}; }
+
+	BytecodeStepResult ScopeResolver::VisitFunctionDeclarationNode(FunctionDeclarationNode& node)
+	{
+		// Declared before the body is resolved so the function can call itself.
+		m_Resolution.m_Slots[&node]
+			= {VariableSlot::Kind::Local, DeclareLocal(node.GetPrototype()->GetName()->GetName(), &node)};
+
+		return ResolveFunction(node, node.GetPrototype()->GetArgs(), *node.GetBlock());
+	}
+
+	BytecodeStepResult ScopeResolver::VisitFunctionCallNode(FunctionCallNode& node)
+	{
+		TRY(ResolveUse(*node.GetName()));
+
+		for(auto& arg : node.GetArgs())
+		{
+			TRY(Visit(*arg));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitBlockNode(BlockNode& node)
+	{
+		BeginScope(node);
+
+		for(auto& statement : node.GetStatements())
+		{
+			TRY(Visit(*statement));
+		}
+
+		EndScope();
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitArithmeticExpressionNode(ArithmeticExpressionNode& node)
+	{
+		if(node.GetOp()->GetOp() == OperatorNode::Operator::Assign && !node.GetLhs()->Is<IdentifierNode>()
+		   && !node.GetLhs()->Is<IndexExpressionNode>() && !node.GetLhs()->Is<FieldExpressionNode>())
+		{
+			return BytecodeStepResult(&node,
+									  absl::InvalidArgumentError("Can only assign to a variable, an index or a field"));
+		}
+
+		TRY(Visit(*node.GetLhs()));
+		TRY(Visit(*node.GetRhs()));
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitIfExpressionNode(IfExpressionNode& node)
+	{
+		TRY(Visit(*node.GetCondition()));
+		TRY(Visit(*node.GetTrueBranch()));
+		if(auto& falseBranch = node.GetFalseBranch())
+		{
+			TRY(Visit(*falseBranch));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitMatchExpressionNode(MatchExpressionNode& node)
+	{
+		TRY(Visit(*node.GetExpression()));
+		for(auto& matchCase : node.GetCases())
+		{
+			TRY(Visit(*matchCase));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitMatchCaseNode(MatchCaseNode& node)
+	{
+		TRY(Visit(*node.GetPattern()));
+		TRY(Visit(*node.GetBlock()));
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitLambdaExpressionNode(LambdaExpressionNode& node)
+	{
+		return ResolveFunction(node, node.GetArgs(), *node.GetBlock());
+	}
+
+	BytecodeStepResult ScopeResolver::VisitIdentifierNode(IdentifierNode& node) { return ResolveUse(node); }
+
+	BytecodeStepResult ScopeResolver::VisitLiteralNode(LiteralNode& node) { return {}; }
+
+	BytecodeStepResult ScopeResolver::VisitArrayLiteralNode(ArrayLiteralNode& node)
+	{
+		for(auto& element : node.GetElements())
+		{
+			TRY(Visit(*element));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitDictLiteralNode(DictLiteralNode& node)
+	{
+		for(auto& [key, value] : node.GetEntries())
+		{
+			TRY(Visit(*key));
+			TRY(Visit(*value));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitRecordLiteralNode(RecordLiteralNode& node)
+	{
+		auto& fields = node.GetFields();
+		for(auto field = fields.begin(); field != fields.end(); ++field)
+		{
+			// A shape has one slot per name, a second value for it would have nowhere to go.
+			if(std::any_of(fields.begin(), field, [&](const auto& other) { return other.first == field->first; }))
+			{
+				return BytecodeStepResult(
+					&node, absl::InvalidArgumentError(absl::StrCat("Duplicate field '", field->first, "'")));
+			}
+
+			TRY(Visit(*field->second));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitIndexExpressionNode(IndexExpressionNode& node)
+	{
+		TRY(Visit(*node.GetObject()));
+		TRY(Visit(*node.GetKey()));
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitFieldExpressionNode(FieldExpressionNode& node)
+	{
+		return Visit(*node.GetObject());
+	}
+
+	BytecodeStepResult ScopeResolver::VisitOperatorNode(OperatorNode& node) { return {}; }
+
+	BytecodeStepResult ScopeResolver::VisitArgumentListNode(ArgumentListNode& node)
+	{
+		for(auto& arg : node.GetArgs())
+		{
+			TRY(Visit(*arg));
+		}
+
+		return {};
+	}
+
+	BytecodeStepResult ScopeResolver::VisitReturnStatementNode(ReturnStatementNode& node)
+	{
+		return Visit(*node.GetExpression());
+	}
+} // namespace Glyph::Bytecode
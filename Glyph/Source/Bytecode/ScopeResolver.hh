@@ -0,0 +1,123 @@
+#pragma once
+
+#include <AST/AST.hh>
+#include <Bytecode/BytecodeStepResult.hh>
+#include <Runtime/FunctionObject.hh>
+#include <Visitors/IASTVisitor.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Glyph::Bytecode
+{
+	struct VariableSlot
+	{
+		enum class Kind
+		{
+			Local,
+			Upvalue,
+			Global
+		};
+
+		enum Kind Kind;
+		uint32_t Index;
+	};
+
+	/// @brief Where every variable of a program lives, produced by ScopeResolver before any bytecode is emitted.
+	class ScopeResolution
+	{
+	  public:
+		/// @brief Slot of a variable use (IdentifierNode) or declaration (LetDeclarationNode).
+		[[nodiscard]] const VariableSlot* Find(const AstNode& node) const;
+
+		/// @brief Node declaring the local a use (IdentifierNode) refers to, its LetDeclarationNode or
+		/// FunctionDeclarationNode. nullptr for parameters and globals.
+		[[nodiscard]] const AstNode* FindDeclaration(const AstNode& node) const;
+
+		/// @brief Number of local slots needed by a frame (ProgramNode, FunctionDeclarationNode or
+		/// LambdaExpressionNode), parameters included.
+		[[nodiscard]] uint32_t GetLocalCount(const AstNode& frame) const;
+
+		/// @brief Variables a function (FunctionDeclarationNode or LambdaExpressionNode) captures from the
+		/// functions around it, indexed by the Upvalue slots of its body.
+		[[nodiscard]] const std::vector<UpvalueDescriptor>& GetUpvalues(const AstNode& frame) const;
+
+		/// @brief First local slot of a block whose locals are captured, the upvalues pointing at that slot and above
+		/// have to be closed when the block ends. Empty when nothing declared in the block is captured.
+		[[nodiscard]] std::optional<uint32_t> FindClosingSlot(const BlockNode& block) const;
+
+		[[nodiscard]] uint32_t GetGlobalCount() const { return m_GlobalNames.size(); }
+		[[nodiscard]] const std::vector<std::string>& GetGlobalNames() const { return m_GlobalNames; }
+
+	  private:
+		friend class ScopeResolver;
+
+		absl::flat_hash_map<const AstNode*, VariableSlot> m_Slots;
+		absl::flat_hash_map<const AstNode*, const AstNode*> m_Declarations;
+		absl::flat_hash_map<const AstNode*, uint32_t> m_LocalCounts;
+		absl::flat_hash_map<const AstNode*, std::vector<UpvalueDescriptor>> m_Upvalues;
+		absl::flat_hash_map<const AstNode*, uint32_t> m_ClosingSlots;
+		std::vector<std::string> m_GlobalNames;
+	};
+
+	/// @brief Assigns every local a fixed slot in its frame so the VM accesses variables by index, never by name.
+	/// Top-level lets are globals and are hoisted, anything declared inside a block or function is a local.
+	/// Locals of an enclosing function become upvalues of every function between it and the use.
+	class ScopeResolver : public IASTVisitor<BytecodeStepResult>
+	{
+	  public:
+		static BytecodeStepResult Resolve(ProgramNode& program, ScopeResolution& resolution);
+
+#define DEFINE_VISIT_METHOD(name) BytecodeStepResult Visit##name(name& node) override;
+		AST_NODE_LIST(DEFINE_VISIT_METHOD)
+#undef DEFINE_VISIT_METHOD
+
+		BytecodeStepResult Visit(AstNode& node) override;
+
+	  private:
+		explicit ScopeResolver(ScopeResolution& resolution);
+
+		struct Binding
+		{
+			std::string Name;
+			uint32_t Slot;
+			const AstNode* Declaration;
+		};
+
+		struct Scope
+		{
+			const AstNode* Node;
+			std::vector<Binding> Names;
+			uint32_t FirstSlot;
+			bool Captured;
+		};
+
+		struct Frame
+		{
+			const AstNode* Node;
+			std::vector<Scope> Scopes;
+			std::vector<UpvalueDescriptor> Upvalues;
+			uint32_t NextSlot;
+			uint32_t MaxSlots;
+		};
+
+		void BeginFrame(const AstNode& node, const std::vector<std::string>& params);
+		void EndFrame();
+		void BeginScope(const AstNode& node);
+		void EndScope();
+
+		uint32_t DeclareLocal(const std::string& name, const AstNode* declaration);
+		static uint32_t AddUpvalue(Frame& frame, UpvalueDescriptor upvalue);
+		BytecodeStepResult ResolveUse(IdentifierNode& node);
+		BytecodeStepResult ResolveFunction(const AstNode& node, const std::vector<std::string>& params, BlockNode& body);
+
+	  private:
+		ScopeResolution& m_Resolution;
+		absl::flat_hash_map<std::string, uint32_t> m_Globals;
+		std::vector<Frame> m_Frames;
+	};
+} // namespace Glyph::Bytecode
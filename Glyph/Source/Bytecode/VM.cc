@@ -0,0 +1,1220 @@
+#include <Bytecode/BytecodeInstruction.hh>
+#include <Bytecode/Natives.hh>
+#include <Bytecode/VM.hh>
+#include <Runtime/ClosureObject.hh>
+#include <Runtime/DictObject.hh>
+#include <Runtime/FunctionObject.hh>
+#include <Runtime/RecordObject.hh>
+#include <Runtime/RopeObject.hh>
+#include <Runtime/StringObject.hh>
+#include <Runtime/UpvalueObject.hh>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <string>
+
+// Labels-as-values dispatch jumps straight from one handler to the next instead of going through a single switch,
+// which gives the branch predictor a separate indirect branch per opcode. Fall back to a switch elsewhere.
+#if !defined(GLYPH_DISABLE_COMPUTED_GOTO) && (defined(__GNUC__) || defined(__clang__))
+#	define GLYPH_COMPUTED_GOTO 1
+#else
+#	define GLYPH_COMPUTED_GOTO 0
+#endif
+
+namespace
+{
+	bool IsText(const Glyph::Value& value)
+	{
+		auto* object = value.AsObject();
+
+		return object && (object->IsType(Glyph::ObjectType::String) || object->IsType(Glyph::ObjectType::Rope));
+	}
+
+	bool IsRope(const Glyph::Value& value)
+	{
+		auto* object = value.AsObject();
+
+		return object && object->IsType(Glyph::ObjectType::Rope);
+	}
+
+	Glyph::NativeObject* AsNative(const Glyph::Value& value)
+	{
+		auto* object = value.AsObject();
+
+		return object ? object->As<Glyph::NativeObject>() : nullptr;
+	}
+
+	// Miss path of GET_FIELD and SET_FIELD, the slot is remembered for the shape until the site has seen too many.
+	std::optional<uint32_t> FindField(Glyph::Bytecode::FieldCache& cache, const Glyph::Shape* shape)
+	{
+		auto slot = shape->Find(cache.Name);
+		if(!slot || cache.Megamorphic)
+		{
+			return slot;
+		}
+
+		if(cache.EntryCount == Glyph::Bytecode::FieldCache::MaxEntries)
+		{
+			cache.Megamorphic = true;
+			return slot;
+		}
+
+		cache.Shapes[cache.EntryCount] = shape;
+		cache.Slots[cache.EntryCount] = *slot;
+		cache.EntryCount++;
+
+		return slot;
+	}
+} // namespace
+
+namespace Glyph::Bytecode
+{
+	VM::VM(HeapOptions heapOptions)
+		: m_Stack(std::make_unique<Value[]>(StackSize))
+		, m_StackTop(m_Stack.get())
+		, m_Frames(std::make_unique<CallFrame[]>(FramesSize))
+		, m_FrameCount(0)
+		, m_Heap(heapOptions)
+	{
+		for(const auto& native : GetNatives())
+		{
+			m_Natives.push_back(
+				std::make_unique<NativeObject>(std::string(native.Name), native.Arity, native.Function));
+		}
+	}
+
+	VM::~VM()
+	{
+		Reset();
+	}
+
+	absl::StatusOr<Value> VM::Run(const BytecodeChunk& chunk)
+	{
+		if(!chunk.IsVerified())
+		{
+			return absl::FailedPreconditionError("VM: Chunk has not been verified");
+		}
+
+		Reset();
+
+		if(chunk.LocalCount() > StackSize)
+		{
+			return absl::ResourceExhaustedError("VM: Stack overflow");
+		}
+
+		m_Globals.assign(chunk.GlobalCount(), Value());
+		for(std::size_t i = 0; i < std::min(m_Natives.size(), m_Globals.size()); i++)
+		{
+			m_Globals[i] = Value(m_Natives[i].get());
+		}
+
+		m_Chunk = &chunk;
+		AddChunkStrings(chunk);
+		chunk.ClearCaches();
+
+		auto& frame = m_Frames[m_FrameCount++];
+		frame.Chunk = &chunk;
+		frame.Ip = chunk.Bytecode();
+		frame.Base = m_StackTop;
+		frame.Closure = nullptr;
+
+		// Locals live in fixed slots right above the frame base, temporaries go on top of them.
+		std::fill(frame.Base, frame.Base + chunk.LocalCount(), Value());
+		m_StackTop += chunk.LocalCount();
+
+		auto result = Execute();
+		if(!result.ok())
+		{
+			Reset();
+		}
+
+		return result;
+	}
+
+	void VM::Reset()
+	{
+		m_StackTop = m_Stack.get();
+		m_FrameCount = 0;
+		m_OpenUpvalues = nullptr;
+		m_Chunk = nullptr;
+		m_Globals.clear();
+
+		m_Heap.Clear();
+	}
+
+	void VM::CollectGarbage()
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		// A cycle in progress started marking before the latest garbage appeared, finish it and run a whole one.
+		while(m_Heap.GetPhase() != CollectionPhase::Idle)
+		{
+			StepCollector(Heap::Deadline::max());
+		}
+
+		do
+		{
+			StepCollector(Heap::Deadline::max());
+		} while(m_Heap.GetPhase() != CollectionPhase::Idle);
+
+		m_Pauses.Record(std::chrono::steady_clock::now() - start);
+	}
+
+	bool VM::CollectGarbageSlice(std::chrono::microseconds budget)
+	{
+		if(m_Heap.GetPhase() == CollectionPhase::Idle && !m_Heap.ShouldCollect())
+		{
+			return false;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		StepCollector(start + budget);
+		m_Pauses.Record(std::chrono::steady_clock::now() - start);
+
+		return m_Heap.GetPhase() != CollectionPhase::Idle;
+	}
+
+	VMStats VM::GetStats() const
+	{
+		return VMStats {
+			.HeapBytes = m_Heap.GetAllocatedBytes(),
+			.HeapBlocks = m_Heap.GetBlockCount(),
+			.Collections = m_Heap.GetCollectionCount(),
+			.Phase = m_Heap.GetPhase(),
+			.Pauses = m_Pauses,
+		};
+	}
+
+	void VM::RunCollector()
+	{
+		if(!m_Heap.GetOptions().Incremental)
+		{
+			CollectGarbage();
+			return;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		StepCollector(start + m_Heap.GetOptions().SliceBudget);
+		m_Pauses.Record(std::chrono::steady_clock::now() - start);
+	}
+
+	void VM::StepCollector(Heap::Deadline deadline)
+	{
+		switch(m_Heap.GetPhase())
+		{
+			case CollectionPhase::Idle:
+				// Constants never change while running, marking them once per cycle is enough.
+				m_Heap.BeginMarking();
+				MarkRoots();
+				if(m_Chunk)
+				{
+					MarkChunk(*m_Chunk);
+				}
+				break;
+
+			case CollectionPhase::Marking:
+				if(m_Heap.TraceSlice(deadline))
+				{
+					// The stack and globals changed without barriers since the cycle started, whatever they hold now
+					// is marked in this last pause.
+					MarkRoots();
+					m_Heap.Trace();
+					m_Heap.BeginSweep();
+				}
+				break;
+
+			case CollectionPhase::Sweeping: m_Heap.SweepSlice(deadline); break;
+		}
+	}
+
+	void VM::MarkRoots()
+	{
+		for(auto* value = m_Stack.get(); value != m_StackTop; value++)
+		{
+			m_Heap.Mark(*value);
+		}
+
+		for(std::size_t i = 0; i < m_FrameCount; i++)
+		{
+			m_Heap.Mark(m_Frames[i].Closure);
+		}
+
+		for(auto* upvalue = m_OpenUpvalues; upvalue; upvalue = upvalue->GetNextOpen())
+		{
+			m_Heap.Mark(upvalue);
+		}
+
+		for(const auto& global : m_Globals)
+		{
+			m_Heap.Mark(global);
+		}
+	}
+
+	void VM::MarkChunk(const BytecodeChunk& chunk)
+	{
+		const auto& constants = chunk.GetConstantTable();
+		for(std::size_t i = 0; i < constants.GetSize(); i++)
+		{
+			m_Heap.Mark(constants.GetValueUnchecked(i));
+		}
+
+		for(const auto& function : chunk.Functions())
+		{
+			MarkChunk(function->GetChunk());
+		}
+	}
+
+	void VM::AddChunkStrings(const BytecodeChunk& chunk)
+	{
+		// Strings built at runtime find the literal with the same characters, they stay comparable by pointer.
+		for(const auto& string : chunk.Strings())
+		{
+			m_Heap.AddString(string.get());
+		}
+
+		for(const auto& function : chunk.Functions())
+		{
+			AddChunkStrings(function->GetChunk());
+		}
+	}
+
+	StringObject* VM::Intern(std::string_view chars)
+	{
+		auto hash = StringObject::Hash(chars);
+		if(auto* string = m_Heap.FindString(chars, hash))
+		{
+			return string;
+		}
+
+		auto* string = AllocateSized<StringObject>(StringObject::AllocationSize(chars.size()), chars, hash);
+		m_Heap.AddString(string);
+
+		return string;
+	}
+
+	absl::StatusOr<Value> VM::Concatenate(Object* lhs, Object* rhs)
+	{
+		auto length = static_cast<std::size_t>(RopeObject::LengthOf(lhs)) + RopeObject::LengthOf(rhs);
+		if(length > StringObject::MaxLength)
+		{
+			return absl::ResourceExhaustedError("VM: String too long");
+		}
+
+		if(length < RopeObject::MinLength)
+		{
+			std::string chars;
+			chars.reserve(length);
+			RopeObject::AppendTo(chars, lhs);
+			RopeObject::AppendTo(chars, rhs);
+
+			return Value(Intern(chars));
+		}
+
+		// Both pieces are still on the stack, a collection while allocating keeps them.
+		auto* rope = Allocate<RopeObject>(lhs, rhs, static_cast<uint32_t>(length));
+		m_Heap.WriteBarrier(rope, lhs);
+		m_Heap.WriteBarrier(rope, rhs);
+
+		return Value(rope);
+	}
+
+	absl::StatusOr<Float64ArrayObject*> VM::NewFloat64Array(std::size_t length)
+	{
+		if(length > Float64ArrayObject::MaxLength)
+		{
+			return absl::ResourceExhaustedError("VM: Array too long");
+		}
+
+		return AllocateSized<Float64ArrayObject>(Float64ArrayObject::AllocationSize(length),
+												 static_cast<uint32_t>(length));
+	}
+
+	Value VM::Flatten(const Value& value)
+	{
+		if(!IsRope(value))
+		{
+			return value;
+		}
+
+		auto* rope = static_cast<RopeObject*>(value.AsObject());
+		if(!rope->GetFlat())
+		{
+			auto* flat = Intern(rope->Join());
+			rope->SetFlat(flat);
+			m_Heap.WriteBarrier(rope, flat);
+		}
+
+		return Value(rope->GetFlat());
+	}
+
+	UpvalueObject* VM::CaptureUpvalue(Value* slot)
+	{
+		// Open upvalues are sorted by descending slot, the captured locals of the innermost frames come first.
+		UpvalueObject* previous = nullptr;
+		UpvalueObject* upvalue = m_OpenUpvalues;
+		while(upvalue && upvalue->GetLocation() > slot)
+		{
+			previous = upvalue;
+			upvalue = upvalue->GetNextOpen();
+		}
+
+		if(upvalue && upvalue->GetLocation() == slot)
+		{
+			return upvalue;
+		}
+
+		auto* created = Allocate<UpvalueObject>(slot);
+		created->SetNextOpen(upvalue);
+
+		if(previous)
+		{
+			previous->SetNextOpen(created);
+		}
+		else
+		{
+			m_OpenUpvalues = created;
+		}
+
+		return created;
+	}
+
+	void VM::CloseUpvalues(Value* last)
+	{
+		while(m_OpenUpvalues && m_OpenUpvalues->GetLocation() >= last)
+		{
+			auto* upvalue = m_OpenUpvalues;
+			upvalue->Close();
+			m_Heap.WriteBarrier(upvalue, *upvalue->GetLocation());
+			m_OpenUpvalues = upvalue->GetNextOpen();
+			upvalue->SetNextOpen(nullptr);
+		}
+	}
+
+	absl::StatusOr<Value> VM::Execute()
+	{
+		CallFrame* frame = &m_Frames[m_FrameCount - 1];
+		const Instruction* code = frame->Chunk->Bytecode();
+		const Instruction* ip = frame->Ip;
+		const ConstantTable* constants = &frame->Chunk->GetConstantTable();
+		Value* base = frame->Base;
+		Value* stackTop = m_StackTop;
+		Value* const stackEnd = m_Stack.get() + StackSize;
+		Value* const globals = m_Globals.data();
+
+		// Every handler sees the decoded word of the instruction it runs, ip already points at the next one.
+		Instruction instruction;
+		uint32_t operand;
+
+#define FETCH()                                                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		instruction = *ip++;                                                                                           \
+		operand = instruction.GetOperand();                                                                            \
+	}                                                                                                                  \
+	while(0)
+#define PUSH(value)                                                                                                    \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if(stackTop == stackEnd) [[unlikely]]                                                                          \
+			return absl::ResourceExhaustedError("VM: Stack overflow");                                                 \
+		*stackTop++ = (value);                                                                                         \
+	}                                                                                                                  \
+	while(0)
+#define PEEK(distance) (stackTop[-1 - (distance)])
+
+#define BINARY_NUMBER_OP(TResult, op)                                                                                  \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto& lhs = PEEK(1);                                                                                           \
+		auto& rhs = PEEK(0);                                                                                           \
+		if(!lhs.IsNumber() || !rhs.IsNumber()) [[unlikely]]                                                            \
+			return absl::InvalidArgumentError("VM: Operands of '" #op "' must be numbers");                            \
+                                                                                                                       \
+		lhs = Value(TResult(lhs.AsNumber() op rhs.AsNumber()));                                                        \
+		stackTop--;                                                                                                    \
+	}                                                                                                                  \
+	while(0)
+
+#define JUMP_UNLESS_NUMBER_COMPARE(op)                                                                                 \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto& lhs = PEEK(1);                                                                                           \
+		auto& rhs = PEEK(0);                                                                                           \
+		if(!lhs.IsNumber() || !rhs.IsNumber()) [[unlikely]]                                                            \
+			return absl::InvalidArgumentError("VM: Operands of '" #op "' must be numbers");                            \
+                                                                                                                       \
+		if(!(lhs.AsNumber() op rhs.AsNumber()))                                                                        \
+			ip = code + operand;                                                                                       \
+		stackTop -= 2;                                                                                                 \
+	}                                                                                                                  \
+	while(0)
+
+#define FLATTEN_ROPES(lhs, rhs)                                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if(IsRope(lhs) || IsRope(rhs)) [[unlikely]]                                                                    \
+		{                                                                                                              \
+			m_StackTop = stackTop;                                                                                     \
+			lhs = Flatten(lhs);                                                                                        \
+			rhs = Flatten(rhs);                                                                                        \
+		}                                                                                                              \
+	}                                                                                                                  \
+	while(0)
+
+#define FLATTEN_KEY(key)                                                                                               \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if(IsRope(key)) [[unlikely]]                                                                                   \
+		{                                                                                                              \
+			m_StackTop = stackTop;                                                                                     \
+			key = Flatten(key);                                                                                        \
+		}                                                                                                              \
+	}                                                                                                                  \
+	while(0)
+
+#define CHECK_DICT(dict, value)                                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto* object = (value).AsObject();                                                                             \
+		dict = object ? object->As<DictObject>() : nullptr;                                                            \
+		if(!dict) [[unlikely]]                                                                                         \
+			return absl::InvalidArgumentError("VM: Can only index dicts and arrays");                                  \
+	}                                                                                                                  \
+	while(0)
+
+#define CHECK_ELEMENT_INDEX(index, array, key)                                                                         \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto& position = (key);                                                                                        \
+		if(!position.IsNumber()) [[unlikely]]                                                                          \
+			return absl::InvalidArgumentError("VM: Array index must be a number");                                     \
+                                                                                                                       \
+		auto number = position.AsNumber();                                                                             \
+		if(!(number >= 0 && number < (array)->GetLength()) || number != std::trunc(number)) [[unlikely]]               \
+			return absl::OutOfRangeError("VM: Array index out of range");                                              \
+                                                                                                                       \
+		index = static_cast<uint32_t>(number);                                                                         \
+	}                                                                                                                  \
+	while(0)
+
+// A monomorphic site hits the first entry of its cache, a polymorphic one scans the few after it.
+#define FIND_FIELD(record, slot, value, cache)                                                                         \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto* object = (value).AsObject();                                                                             \
+		record = object ? object->As<RecordObject>() : nullptr;                                                        \
+		if(!record) [[unlikely]]                                                                                       \
+			return absl::InvalidArgumentError("VM: Can only access fields of records");                                \
+                                                                                                                       \
+		auto* shape = record->GetShape();                                                                              \
+		uint32_t entry = 0;                                                                                            \
+		while(entry < (cache).EntryCount && (cache).Shapes[entry] != shape)                                            \
+			entry++;                                                                                                   \
+                                                                                                                       \
+		if(entry < (cache).EntryCount) [[likely]]                                                                      \
+			slot = (cache).Slots[entry];                                                                               \
+		else if(auto found = FindField(cache, shape))                                                                  \
+			slot = *found;                                                                                             \
+		else                                                                                                           \
+			return absl::InvalidArgumentError(absl::StrCat("VM: Record has no field '", (cache).Name, "'"));           \
+	}                                                                                                                  \
+	while(0)
+
+#define CALL_NATIVE(native, arguments)                                                                                 \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if((native)->GetArity() != operand) [[unlikely]]                                                               \
+			return absl::InvalidArgumentError(absl::StrCat("VM: ", (native)->GetName(), " expects ",                   \
+													   (native)->GetArity(), " arguments but got ", operand));         \
+                                                                                                                       \
+		m_StackTop = stackTop;                                                                                         \
+		auto result = (native)->GetFunction()(*this, arguments);                                                       \
+		if(!result.ok()) [[unlikely]]                                                                                  \
+			return result.status();                                                                                    \
+                                                                                                                       \
+		stackTop = (arguments);                                                                                        \
+		stackTop[-1] = *result;                                                                                        \
+	}                                                                                                                  \
+	while(0)
+
+#define RETURN_FROM_FRAME(value)                                                                                       \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto result = (value);                                                                                         \
+                                                                                                                       \
+		CloseUpvalues(base);                                                                                           \
+		stackTop = base;                                                                                               \
+		m_FrameCount--;                                                                                                \
+                                                                                                                       \
+		if(m_FrameCount == 0)                                                                                          \
+		{                                                                                                              \
+			m_StackTop = stackTop;                                                                                     \
+			return result;                                                                                             \
+		}                                                                                                              \
+                                                                                                                       \
+		/* The result replaces the callee below the arguments. */                                                      \
+		stackTop[-1] = result;                                                                                         \
+                                                                                                                       \
+		frame = &m_Frames[m_FrameCount - 1];                                                                           \
+		code = frame->Chunk->Bytecode();                                                                               \
+		ip = frame->Ip;                                                                                                \
+		base = frame->Base;                                                                                            \
+		constants = &frame->Chunk->GetConstantTable();                                                                 \
+	}                                                                                                                  \
+	while(0)
+
+#define CHECK_CALLEE(function, closure, callee)                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		auto& value = (callee);                                                                                        \
+		function = nullptr;                                                                                            \
+		closure = nullptr;                                                                                             \
+		if(value.IsObject())                                                                                           \
+		{                                                                                                              \
+			auto* object = value.AsObject();                                                                           \
+			if((closure = object->As<ClosureObject>()))                                                                \
+				function = closure->GetFunction();                                                                     \
+			else                                                                                                       \
+				function = object->As<FunctionObject>();                                                               \
+		}                                                                                                              \
+		if(!function) [[unlikely]]                                                                                     \
+			return absl::InvalidArgumentError("VM: Can only call functions");                                          \
+                                                                                                                       \
+		if(function->GetArity() != operand) [[unlikely]]                                                               \
+			return absl::InvalidArgumentError(absl::StrCat("VM: ", function->GetName(), " expects ",                   \
+														   function->GetArity(), " arguments but got ", operand));     \
+	}                                                                                                                  \
+	while(0)
+
+#if GLYPH_COMPUTED_GOTO
+#	define LABEL_ADDRESS(name, _) &&L_##name,
+		static const void* const dispatchTable[] = {INSTRUCTION_LIST(LABEL_ADDRESS)};
+#	undef LABEL_ADDRESS
+
+#	define DISPATCH()                                                                                                  \
+		do                                                                                                             \
+		{                                                                                                              \
+			FETCH();                                                                                                   \
+			goto* dispatchTable[static_cast<std::size_t>(instruction.GetType())];                                      \
+		}                                                                                                              \
+		while(0)
+#	define HANDLER(name) L_##name:
+
+		DISPATCH();
+#else
+#	define DISPATCH() continue
+#	define HANDLER(name) case Opcode::name:
+
+		while(true)
+		{
+			FETCH();
+		reswitch:
+			switch(instruction.GetType())
+			{
+#endif
+
+		HANDLER(WIDE)
+		{
+			// Extend the operand of the following instruction and run it without going through FETCH again.
+			auto highBits = operand;
+			instruction = *ip++;
+			operand = (highBits << Instruction::OperandBits) | instruction.GetOperand();
+#if GLYPH_COMPUTED_GOTO
+			goto* dispatchTable[static_cast<std::size_t>(instruction.GetType())];
+#else
+			goto reswitch;
+#endif
+		}
+
+		HANDLER(LOAD_CONST)
+		{
+			PUSH(constants->GetValueUnchecked(operand));
+			DISPATCH();
+		}
+
+		HANDLER(LOAD_NULL)
+		{
+			PUSH(Value());
+			DISPATCH();
+		}
+
+		HANDLER(LOAD_LOCAL)
+		{
+			PUSH(base[operand]);
+			DISPATCH();
+		}
+
+		HANDLER(STORE_LOCAL)
+		{
+			base[operand] = *--stackTop;
+			DISPATCH();
+		}
+
+		HANDLER(LOAD_GLOBAL)
+		{
+			PUSH(globals[operand]);
+			DISPATCH();
+		}
+
+		HANDLER(STORE_GLOBAL)
+		{
+			globals[operand] = *--stackTop;
+			DISPATCH();
+		}
+
+		HANDLER(LOAD_UPVALUE)
+		{
+			PUSH(*frame->Closure->GetUpvalues()[operand]->GetLocation());
+			DISPATCH();
+		}
+
+		HANDLER(STORE_UPVALUE)
+		{
+			auto* upvalue = frame->Closure->GetUpvalues()[operand];
+			*upvalue->GetLocation() = *--stackTop;
+			m_Heap.WriteBarrier(upvalue, *upvalue->GetLocation());
+			DISPATCH();
+		}
+
+		HANDLER(CLOSURE)
+		{
+			const auto* function = constants->GetValueUnchecked(operand).AsObject()->As<FunctionObject>();
+
+			// Capturing allocates too, the closure is pushed first so a collection in between sees it.
+			m_StackTop = stackTop;
+			auto* closure = Allocate<ClosureObject>(function);
+			PUSH(Value(closure));
+			m_StackTop = stackTop;
+
+			// Locals of this frame are captured directly, anything further out is passed down from our own closure.
+			for(const auto& upvalue : function->GetUpvalues())
+			{
+				auto* captured = upvalue.IsLocal ? CaptureUpvalue(base + upvalue.Index)
+												 : frame->Closure->GetUpvalues()[upvalue.Index];
+				closure->GetUpvalues().push_back(captured);
+				m_Heap.WriteBarrier(closure, captured);
+			}
+
+			DISPATCH();
+		}
+
+		HANDLER(CLOSE_UPVALUES)
+		{
+			CloseUpvalues(base + operand);
+			DISPATCH();
+		}
+
+		HANDLER(LOAD_CALLER_LOCAL)
+		{
+			PUSH(frame[-1].Base[operand]);
+			DISPATCH();
+		}
+
+		HANDLER(STORE_CALLER_LOCAL)
+		{
+			frame[-1].Base[operand] = *--stackTop;
+			DISPATCH();
+		}
+
+		HANDLER(POP)
+		{
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(DUP)
+		{
+			auto top = PEEK(0);
+			PUSH(top);
+			DISPATCH();
+		}
+
+		HANDLER(ADD)
+		{
+			auto& lhs = PEEK(1);
+			auto& rhs = PEEK(0);
+			if(lhs.IsNumber() && rhs.IsNumber()) [[likely]]
+			{
+				lhs = Value(lhs.AsNumber() + rhs.AsNumber());
+			}
+			else if(IsText(lhs) && IsText(rhs))
+			{
+				m_StackTop = stackTop;
+				auto result = Concatenate(lhs.AsObject(), rhs.AsObject());
+				if(!result.ok()) [[unlikely]]
+				{
+					return result.status();
+				}
+				lhs = *result;
+			}
+			else [[unlikely]]
+			{
+				return absl::InvalidArgumentError("VM: Operands of '+' must be numbers or strings");
+			}
+
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(SUB)
+		{
+			BINARY_NUMBER_OP(double, -);
+			DISPATCH();
+		}
+
+		HANDLER(MUL)
+		{
+			BINARY_NUMBER_OP(double, *);
+			DISPATCH();
+		}
+
+		HANDLER(DIV)
+		{
+			BINARY_NUMBER_OP(double, /);
+			DISPATCH();
+		}
+
+		HANDLER(LESS)
+		{
+			BINARY_NUMBER_OP(bool, <);
+			DISPATCH();
+		}
+
+		HANDLER(GREATER)
+		{
+			BINARY_NUMBER_OP(bool, >);
+			DISPATCH();
+		}
+
+		HANDLER(LESS_EQUAL)
+		{
+			BINARY_NUMBER_OP(bool, <=);
+			DISPATCH();
+		}
+
+		HANDLER(GREATER_EQUAL)
+		{
+			BINARY_NUMBER_OP(bool, >=);
+			DISPATCH();
+		}
+
+		HANDLER(EQUAL)
+		{
+			FLATTEN_ROPES(PEEK(1), PEEK(0));
+			PEEK(1) = Value(PEEK(1) == PEEK(0));
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(NOT_EQUAL)
+		{
+			FLATTEN_ROPES(PEEK(1), PEEK(0));
+			PEEK(1) = Value(!(PEEK(1) == PEEK(0)));
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(DICT_NEW)
+		{
+			// Keys are flattened before the dict exists, interning one may collect and nothing would keep it.
+			auto* entries = stackTop - 2 * static_cast<std::ptrdiff_t>(operand);
+			for(uint32_t i = 0; i < operand; i++)
+			{
+				FLATTEN_KEY(entries[2 * i]);
+			}
+
+			m_StackTop = stackTop;
+			auto* dict = Allocate<DictObject>(operand);
+			for(uint32_t i = 0; i < operand; i++)
+			{
+				dict->Set(entries[2 * i], entries[2 * i + 1]);
+				m_Heap.WriteBarrier(dict, entries[2 * i]);
+				m_Heap.WriteBarrier(dict, entries[2 * i + 1]);
+			}
+
+			stackTop = entries;
+			PUSH(Value(dict));
+			DISPATCH();
+		}
+
+		HANDLER(ARRAY_NEW)
+		{
+			auto* elements = stackTop - operand;
+			for(uint32_t i = 0; i < operand; i++)
+			{
+				if(!elements[i].IsNumber()) [[unlikely]]
+					return absl::InvalidArgumentError("VM: Array elements must be numbers");
+			}
+
+			m_StackTop = stackTop;
+			auto* array = AllocateSized<Float64ArrayObject>(Float64ArrayObject::AllocationSize(operand), operand);
+			for(uint32_t i = 0; i < operand; i++)
+			{
+				array->GetData()[i] = elements[i].AsNumber();
+			}
+
+			stackTop = elements;
+			PUSH(Value(array));
+			DISPATCH();
+		}
+
+		HANDLER(INDEX_GET)
+		{
+			auto* object = PEEK(1).AsObject();
+			if(auto* array = object ? object->As<Float64ArrayObject>() : nullptr)
+			{
+				uint32_t index;
+				CHECK_ELEMENT_INDEX(index, array, PEEK(0));
+
+				PEEK(1) = Value(array->GetData()[index]);
+			}
+			else
+			{
+				DictObject* dict;
+				CHECK_DICT(dict, PEEK(1));
+				FLATTEN_KEY(PEEK(0));
+
+				const auto* value = dict->Get(PEEK(0));
+				PEEK(1) = value ? *value : Value();
+			}
+
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(INDEX_SET)
+		{
+			auto* object = PEEK(2).AsObject();
+			if(auto* array = object ? object->As<Float64ArrayObject>() : nullptr)
+			{
+				uint32_t index;
+				CHECK_ELEMENT_INDEX(index, array, PEEK(1));
+				if(!PEEK(0).IsNumber()) [[unlikely]]
+					return absl::InvalidArgumentError("VM: Array elements must be numbers");
+
+				array->GetData()[index] = PEEK(0).AsNumber();
+			}
+			else
+			{
+				DictObject* dict;
+				CHECK_DICT(dict, PEEK(2));
+				FLATTEN_KEY(PEEK(1));
+
+				dict->Set(PEEK(1), PEEK(0));
+				m_Heap.WriteBarrier(dict, PEEK(1));
+				m_Heap.WriteBarrier(dict, PEEK(0));
+			}
+
+			// The assignment evaluates to the assigned value.
+			PEEK(2) = PEEK(0);
+			stackTop -= 2;
+			DISPATCH();
+		}
+
+		HANDLER(DICT_CONTAINS)
+		{
+			DictObject* dict;
+			CHECK_DICT(dict, PEEK(0));
+			FLATTEN_KEY(PEEK(1));
+
+			PEEK(1) = Value(dict->Contains(PEEK(1)));
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(RECORD_NEW)
+		{
+			auto& layout = frame->Chunk->RecordLayouts()[operand];
+			if(!layout.CachedShape) [[unlikely]]
+			{
+				auto* shape = &m_RootShape;
+				for(const auto& name : layout.Fields)
+				{
+					shape = shape->AddField(name);
+				}
+				layout.CachedShape = shape;
+			}
+
+			auto count = layout.CachedShape->GetFieldCount();
+			auto* fields = stackTop - count;
+
+			m_StackTop = stackTop;
+			auto* record = AllocateSized<RecordObject>(RecordObject::AllocationSize(count), layout.CachedShape);
+			for(uint32_t i = 0; i < count; i++)
+			{
+				record->GetSlots()[i] = fields[i];
+				m_Heap.WriteBarrier(record, fields[i]);
+			}
+
+			stackTop = fields;
+			PUSH(Value(record));
+			DISPATCH();
+		}
+
+		HANDLER(GET_FIELD)
+		{
+			auto& cache = frame->Chunk->FieldCaches()[operand];
+			RecordObject* record;
+			uint32_t slot;
+			FIND_FIELD(record, slot, PEEK(0), cache);
+
+			PEEK(0) = record->GetSlots()[slot];
+			DISPATCH();
+		}
+
+		HANDLER(SET_FIELD)
+		{
+			auto& cache = frame->Chunk->FieldCaches()[operand];
+			RecordObject* record;
+			uint32_t slot;
+			FIND_FIELD(record, slot, PEEK(1), cache);
+
+			record->GetSlots()[slot] = PEEK(0);
+			m_Heap.WriteBarrier(record, PEEK(0));
+
+			// The assignment evaluates to the assigned value.
+			PEEK(1) = PEEK(0);
+			stackTop--;
+			DISPATCH();
+		}
+
+		HANDLER(JUMP)
+		{
+			ip = code + operand;
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_FALSE)
+		{
+			if(!(*--stackTop).IsTruthy())
+			{
+				ip = code + operand;
+			}
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_TRUE)
+		{
+			if((*--stackTop).IsTruthy())
+			{
+				ip = code + operand;
+			}
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_NOT_LT)
+		{
+			JUMP_UNLESS_NUMBER_COMPARE(<);
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_NOT_GT)
+		{
+			JUMP_UNLESS_NUMBER_COMPARE(>);
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_NOT_LE)
+		{
+			JUMP_UNLESS_NUMBER_COMPARE(<=);
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_NOT_GE)
+		{
+			JUMP_UNLESS_NUMBER_COMPARE(>=);
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_NOT_EQ)
+		{
+			FLATTEN_ROPES(PEEK(1), PEEK(0));
+			if(!(PEEK(1) == PEEK(0)))
+			{
+				ip = code + operand;
+			}
+			stackTop -= 2;
+			DISPATCH();
+		}
+
+		HANDLER(JUMP_IF_NOT_NE)
+		{
+			FLATTEN_ROPES(PEEK(1), PEEK(0));
+			if(PEEK(1) == PEEK(0))
+			{
+				ip = code + operand;
+			}
+			stackTop -= 2;
+			DISPATCH();
+		}
+
+		HANDLER(SWITCH_TABLE)
+		{
+			const auto& table = frame->Chunk->JumpTables()[operand];
+			auto target = table.Default;
+
+			if(auto& scrutinee = PEEK(0); scrutinee.IsNumber())
+			{
+				// NaN and non-integral numbers fail one of the comparisons and take the default.
+				auto offset = scrutinee.AsNumber() - table.Low;
+				if(offset >= 0 && offset < table.Targets.size())
+				{
+					auto index = static_cast<std::size_t>(offset);
+					if(index == offset)
+					{
+						target = table.Targets[index];
+					}
+				}
+			}
+
+			ip = code + target;
+			DISPATCH();
+		}
+
+		HANDLER(SWITCH_SORTED)
+		{
+			const auto& table = frame->Chunk->SortedJumpTables()[operand];
+			auto target = table.Default;
+
+			if(auto& scrutinee = PEEK(0); scrutinee.IsNumber())
+			{
+				auto key = scrutinee.AsNumber();
+				auto it = std::lower_bound(table.Keys.begin(), table.Keys.end(), key);
+				if(it != table.Keys.end() && *it == key)
+				{
+					target = table.Targets[it - table.Keys.begin()];
+				}
+			}
+
+			ip = code + target;
+			DISPATCH();
+		}
+
+		HANDLER(CALL)
+		{
+			Value* calleeBase = stackTop - operand;
+			if(auto* native = AsNative(calleeBase[-1])) [[unlikely]]
+			{
+				CALL_NATIVE(native, calleeBase);
+				DISPATCH();
+			}
+
+			const FunctionObject* function;
+			ClosureObject* closure;
+			CHECK_CALLEE(function, closure, calleeBase[-1]);
+
+			if(m_FrameCount == FramesSize) [[unlikely]]
+				return absl::ResourceExhaustedError("VM: Call stack overflow");
+
+			// Zero for everything but lambdas borrowing their caller's locals, which the caller has to have.
+			if(function->GetCallerLocalCount() > frame->Chunk->LocalCount()) [[unlikely]]
+				return absl::InvalidArgumentError(
+					absl::StrCat("VM: ", function->GetName(), " called outside of the frame defining it"));
+
+			const auto& chunk = function->GetChunk();
+			if(static_cast<std::size_t>(stackEnd - calleeBase) < chunk.LocalCount()) [[unlikely]]
+				return absl::ResourceExhaustedError("VM: Stack overflow");
+
+			// The arguments already are the first locals of the new frame, only the rest needs clearing.
+			std::fill(stackTop, calleeBase + chunk.LocalCount(), Value());
+
+			frame->Ip = ip;
+			frame = &m_Frames[m_FrameCount++];
+			frame->Chunk = &chunk;
+			frame->Base = calleeBase;
+			frame->Closure = closure;
+
+			code = chunk.Bytecode();
+			ip = code;
+			base = calleeBase;
+			constants = &chunk.GetConstantTable();
+			stackTop = calleeBase + chunk.LocalCount();
+			DISPATCH();
+		}
+
+		HANDLER(TAIL_CALL)
+		{
+			Value* arguments = stackTop - operand;
+			if(auto* native = AsNative(arguments[-1])) [[unlikely]]
+			{
+				// Natives don't need a frame to reuse, this one returns their result right away.
+				CALL_NATIVE(native, arguments);
+				RETURN_FROM_FRAME(PEEK(0));
+				DISPATCH();
+			}
+
+			const FunctionObject* function;
+			ClosureObject* closure;
+			CHECK_CALLEE(function, closure, arguments[-1]);
+
+			if(function->GetCallerLocalCount() != 0) [[unlikely]]
+				return absl::InvalidArgumentError(
+					absl::StrCat("VM: ", function->GetName(), " borrows its caller's frame and can't be tail called"));
+
+			const auto& chunk = function->GetChunk();
+			if(static_cast<std::size_t>(stackEnd - base) < chunk.LocalCount()) [[unlikely]]
+				return absl::ResourceExhaustedError("VM: Stack overflow");
+
+			// Callee and arguments slide down over the current frame, which is reused instead of pushing a new one.
+			// Its locals die here, closures that captured them keep their own copies.
+			CloseUpvalues(base);
+			std::copy(arguments - 1, stackTop, base - 1);
+			std::fill(base + operand, base + chunk.LocalCount(), Value());
+
+			frame->Chunk = &chunk;
+			frame->Closure = closure;
+
+			code = chunk.Bytecode();
+			ip = code;
+			constants = &chunk.GetConstantTable();
+			stackTop = base + chunk.LocalCount();
+			DISPATCH();
+		}
+
+		HANDLER(RETURN)
+		{
+			RETURN_FROM_FRAME(stackTop > base + frame->Chunk->LocalCount() ? PEEK(0) : Value());
+			DISPATCH();
+		}
+
+		HANDLER(END)
+		{
+			auto result = stackTop > base + frame->Chunk->LocalCount() ? PEEK(0) : Value();
+
+			m_StackTop = stackTop;
+			frame->Ip = ip;
+
+			return result;
+		}
+
+#if !GLYPH_COMPUTED_GOTO
+				default:
+					return absl::InternalError(std::string("VM: Unknown opcode ")
+											   + std::string(magic_enum::enum_name(instruction.GetType())));
+			}
+		}
+#endif
+
+#undef HANDLER
+#undef DISPATCH
+#undef CHECK_CALLEE
+#undef FLATTEN_ROPES
+#undef FLATTEN_KEY
+#undef CHECK_DICT
+#undef CHECK_ELEMENT_INDEX
+#undef FIND_FIELD
+#undef CALL_NATIVE
+#undef RETURN_FROM_FRAME
+#undef JUMP_UNLESS_NUMBER_COMPARE
+#undef BINARY_NUMBER_OP
+#undef PEEK
+#undef PUSH
+#undef FETCH
+	}
+} // namespace Glyph::Bytecode
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <Bytecode/BytecodeChunk.hh>
+#include <Runtime/ClosureObject.hh>
+#include <Runtime/Float64ArrayObject.hh>
+#include <Runtime/Heap.hh>
+#include <Runtime/NativeObject.hh>
+#include <Runtime/PauseHistogram.hh>
+#include <Runtime/RecordObject.hh>
+#include <Runtime/RopeObject.hh>
+#include <Runtime/StringObject.hh>
+#include <Runtime/UpvalueObject.hh>
+#include <Runtime/Value.hh>
+
+#include <absl/status/statusor.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Glyph::Bytecode
+{
+	/// @brief One active call. Frames live in a fixed array allocated with the VM, calling never allocates.
+	/// Base points at the first argument on the value stack, the callee itself sits right below it.
+	/// Closure is set when the callee captured variables, its upvalues back LOAD_UPVALUE and STORE_UPVALUE.
+	struct CallFrame
+	{
+		const BytecodeChunk* Chunk {nullptr};
+		const Instruction* Ip {nullptr};
+		Value* Base {nullptr};
+		ClosureObject* Closure {nullptr};
+	};
+
+	/// @brief Snapshot of the heap and collector counters, see VM::GetStats.
+	struct VMStats
+	{
+		std::size_t HeapBytes;
+		std::size_t HeapBlocks;
+		std::size_t Collections;
+		CollectionPhase Phase;
+		/// @brief Every stop of the program for the collector, whole collections and single slices alike.
+		PauseHistogram Pauses;
+	};
+
+	class VM
+	{
+	  public:
+		static constexpr std::size_t StackSize = 64 * 1024;
+		static constexpr std::size_t FramesSize = 1024;
+
+	  public:
+		explicit VM(HeapOptions heapOptions = {});
+		~VM();
+
+		VM(const VM&) = delete;
+		VM& operator=(const VM&) = delete;
+
+		/// @brief Executes the chunk from its first instruction until END or the outermost RETURN.
+		/// The chunk must have passed BytecodeVerifier, instructions are not bounds checked while running.
+		/// @return The value left on top of the stack. Objects it references stay alive until the next Run.
+		absl::StatusOr<Value> Run(const BytecodeChunk& chunk);
+
+		[[nodiscard]] std::size_t StackDepth() const { return m_StackTop - m_Stack.get(); }
+
+		/// @brief Frees every object not reachable from the stack, the frames, open upvalues, globals or the
+		/// constants of the running chunk. Runs on its own once the heap grew past its threshold, in slices when the
+		/// heap is incremental. Called directly it finishes a cycle in progress before starting a full one.
+		void CollectGarbage();
+
+		/// @brief Lets an incremental collector use idle time: advances the cycle in progress, or starts one when the
+		/// heap is due, for at most budget.
+		/// @return Whether a cycle is still in progress.
+		bool CollectGarbageSlice(std::chrono::microseconds budget);
+
+		/// @brief A zeroed array, for natives building their result. The arguments of the running native stay rooted
+		/// through a collection.
+		absl::StatusOr<Float64ArrayObject*> NewFloat64Array(std::size_t length);
+
+		[[nodiscard]] const Heap& GetHeap() const { return m_Heap; }
+		[[nodiscard]] VMStats GetStats() const;
+
+	  private:
+		absl::StatusOr<Value> Execute();
+
+		void Reset();
+
+		/// @brief Allocates on the heap, collecting first when it is due. m_StackTop has to be up to date, anything
+		/// above it is not a root.
+		template<typename TObject, typename... TArgs> TObject* Allocate(TArgs&&... args)
+		{
+			return AllocateSized<TObject>(sizeof(TObject), std::forward<TArgs>(args)...);
+		}
+
+		template<typename TObject, typename... TArgs> TObject* AllocateSized(std::size_t size, TArgs&&... args)
+		{
+			if(m_Heap.ShouldCollect()) [[unlikely]]
+			{
+				RunCollector();
+			}
+
+			return m_Heap.AllocateSized<TObject>(size, std::forward<TArgs>(args)...);
+		}
+
+		/// @brief The string with these characters, allocating it unless it is interned already. chars must not
+		/// point into the heap, a collection may run before it is copied.
+		StringObject* Intern(std::string_view chars);
+
+		/// @brief Joins two strings or ropes, into a new rope once the result is long enough.
+		absl::StatusOr<Value> Concatenate(Object* lhs, Object* rhs);
+
+		/// @brief The interned string of a rope, anything else is returned as is. Ropes are flattened before they are
+		/// compared, equal strings are the same object only once interned.
+		Value Flatten(const Value& value);
+
+		/// @brief Interns the literals of a chunk and of its nested functions.
+		void AddChunkStrings(const BytecodeChunk& chunk);
+
+		/// @brief Collection triggered by allocation, a whole one or the next slice of an incremental cycle.
+		void RunCollector();
+
+		/// @brief Runs the current phase of a cycle until it ends or the deadline passes.
+		void StepCollector(Heap::Deadline deadline);
+
+		/// @brief Marks what the program changes without write barriers. Marked when a cycle starts and again
+		/// before marking ends.
+		void MarkRoots();
+		void MarkChunk(const BytecodeChunk& chunk);
+
+		/// @brief Returns the open upvalue for a stack slot, creating it the first time the slot is captured.
+		/// Closures capturing the same variable share one upvalue and see each other's writes.
+		UpvalueObject* CaptureUpvalue(Value* slot);
+
+		/// @brief Closes every open upvalue pointing at last or above, their slots are about to be reused.
+		void CloseUpvalues(Value* last);
+
+	  private:
+		std::unique_ptr<Value[]> m_Stack;
+		Value* m_StackTop;
+
+		std::unique_ptr<CallFrame[]> m_Frames;
+		std::size_t m_FrameCount;
+
+		std::vector<Value> m_Globals;
+		/// @brief One per built-in, stored into the first globals of every program, see GetNatives.
+		std::vector<std::unique_ptr<NativeObject>> m_Natives;
+
+		/// @brief Root of the shape tree of every record built by this VM. Shapes are never freed, a program creates
+		/// one per distinct field sequence.
+		Shape m_RootShape;
+
+		Heap m_Heap;
+		const BytecodeChunk* m_Chunk {nullptr};
+		UpvalueObject* m_OpenUpvalues {nullptr};
+		PauseHistogram m_Pauses;
+	};
+} // namespace Glyph::Bytecode
@@ -1,29 +1,157 @@
 #include <Lexer/Lexer.hh>
 
-#include <map>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace
+{
+	using Glyph::Token;
+
+	struct Keyword
+	{
+		std::string_view Text;
+		Token::ID ID;
+	};
+
+	constexpr Keyword Keywords[] = {
+		// clang-format off
+		{"let", Token::ID::Let},
+		{"return", Token::ID::Return},
+		{"match", Token::ID::Match},
+		{"if", Token::ID::If},
+		{"else", Token::ID::Else},
+		{"in", Token::ID::In},
+		{"true", Token::ID::True},
+		{"false", Token::ID::False},
+		// clang-format on
+	};
+
+	constexpr std::size_t KeywordTableSize = 32;
+	static_assert((KeywordTableSize & (KeywordTableSize - 1)) == 0);
+
+	// Reads the length and the first and last character only, no keyword pair agrees on all three.
+	constexpr std::size_t HashKeyword(std::string_view text, std::pair<uint32_t, uint32_t> seed)
+	{
+		auto first = static_cast<unsigned char>(text.front());
+		auto last = static_cast<unsigned char>(text.back());
+
+		return (text.size() + first * seed.first + last * seed.second) & (KeywordTableSize - 1);
+	}
+
+	// The first multipliers under which every keyword lands in its own slot, searched by the compiler.
+	constexpr std::pair<uint32_t, uint32_t> FindKeywordSeed()
+	{
+		for(uint32_t a = 1; a < 256; a++)
+		{
+			for(uint32_t b = 1; b < 256; b++)
+			{
+				std::array<bool, KeywordTableSize> taken {};
+				bool perfect = true;
+				for(const auto& keyword : Keywords)
+				{
+					auto slot = HashKeyword(keyword.Text, {a, b});
+					perfect = perfect && !taken[slot];
+					taken[slot] = true;
+				}
+
+				if(perfect)
+				{
+					return {a, b};
+				}
+			}
+		}
+
+		return {0, 0};
+	}
+
+	constexpr auto KeywordSeed = FindKeywordSeed();
+	static_assert(KeywordSeed.first != 0, "No perfect hash for the keywords, grow KeywordTableSize");
+
+	// Free slots hold an empty text, which no identifier matches.
+	constexpr std::array<Keyword, KeywordTableSize> KeywordTable = [] {
+		std::array<Keyword, KeywordTableSize> table {};
+		for(const auto& keyword : Keywords)
+		{
+			table[HashKeyword(keyword.Text, KeywordSeed)] = keyword;
+		}
+
+		return table;
+	}();
+
+	// One hash and one comparison against the only keyword the identifier could be, on the source characters.
+	Token::ID ClassifyIdentifier(std::string_view text)
+	{
+		const auto& keyword = KeywordTable[HashKeyword(text, KeywordSeed)];
+
+		return keyword.Text == text ? keyword.ID : Token::ID::Identifier;
+	}
+
+	// Every integer below 2^53 is a double, from it on only some are.
+	constexpr double MaxExactInteger = 9007199254740992.0;
+
+	// All the digits of an integral value. The largest double has 309 of them.
+	std::string FormatInteger(double value)
+	{
+		std::array<char, 320> buffer;
+		auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::fixed);
+
+		return std::string(buffer.data(), result.ptr);
+	}
+} // namespace
 
 namespace Glyph
 {
-	Lexer::Lexer(const std::string& input)
+	Lexer::Lexer(std::string_view source)
 		: m_Start(0)
 		, m_Current(0)
 		, m_Line(1)
-		, m_Column(1)
-		, m_Source(input)
+		, m_LineStart(0)
+		, m_Source(source)
+		, m_Kernels(&GetScanKernels())
 	{
 	}
 
-	Tokens Lexer::Scan()
+	Lexer::Lexer(const SourceFile& file)
+		: Lexer(file.GetText())
+	{
+	}
+
+	Token Lexer::Next()
 	{
-		while(!IsAtEnd())
+		// Whitespace and comments produce no token, keep scanning until something does.
+		while(!m_Token)
 		{
+			if(IsAtEnd())
+			{
+				AddToken(Token::ID::EOI, {});
+				break;
+			}
+
 			m_Start = m_Current;
 			ScanToken();
 		}
 
-		AddToken(Token::ID::EOI);
+		auto token = *m_Token;
+		m_Token.reset();
+
+		return token;
+	}
+
+	Tokens Lexer::Scan()
+	{
+		Tokens tokens;
+		do
+		{
+			tokens.push_back(Next());
+		} while(tokens.back().GetID() != Token::ID::EOI);
 
-		return m_Tokens;
+		return tokens;
 	}
 
 	void Lexer::ScanToken()
@@ -36,21 +164,26 @@ namespace Glyph
 			case ')': AddToken(Token::ID::RightParen); break;
 			case '{': AddToken(Token::ID::LeftBrace); break;
 			case '}': AddToken(Token::ID::RightBrace); break;
+			case '[': AddToken(Token::ID::LeftBracket); break;
+			case ']': AddToken(Token::ID::RightBracket); break;
 			case ',': AddToken(Token::ID::Comma); break;
 			case '.': AddToken(Token::ID::Dot); break;
 			case '-': AddToken(Match('>') ? Token::ID::Arrow : Token::ID::Minus); break;
 			case '+': AddToken(Token::ID::Plus); break;
 			case ';': AddToken(Token::ID::Semicolon); break;
+			case ':': AddToken(Token::ID::Colon); break;
+			case '"': HandleString(); break;
 			case '*': AddToken(Token::ID::Asterisk); break;
 			case '!': AddToken(Match('=') ? Token::ID::BangEqual : Token::ID::Bang); break;
 			case '=': AddToken(Match('=') ? Token::ID::EqualEqual : Token::ID::Equal); break;
 			case '<': AddToken(Match('=') ? Token::ID::LessEqual : Token::ID::Less); break;
 			case '>': AddToken(Match('=') ? Token::ID::GreaterEqual : Token::ID::Greater); break;
+			case '&': AddToken(Match('&') ? Token::ID::And : Token::ID::Unknown); break;
+			case '|': AddToken(Match('|') ? Token::ID::Or : Token::ID::Unknown); break;
 			case '/':
 				if(Match('/'))
 				{
-					while(Peek() != '\n' && !IsAtEnd())
-						Advance();
+					m_Current = m_Kernels->SkipLine(m_Source.data(), m_Current, m_Source.size());
 				}
 				else
 				{
@@ -59,11 +192,8 @@ namespace Glyph
 				break;
 			case ' ':
 			case '\r':
-			case '\t': break;
-			case '\n':
-				m_Line++;
-				m_Column = 1;
-				break;
+			case '\t':
+			case '\n': HandleWhitespace(); break;
 			default:
 				if(IsDigit(c))
 				{
@@ -82,55 +212,99 @@ namespace Glyph
 
 	void Lexer::HandleNumber()
 	{
-		while(IsDigit(Peek()))
-			Advance();
+		m_Current = m_Kernels->SkipDigits(m_Source.data(), m_Current, m_Source.size());
 
 		if(Peek() == '.' && IsDigit(PeekNext()))
 		{
-			Advance();
+			m_Current = m_Kernels->SkipDigits(m_Source.data(), m_Current + 1, m_Source.size());
+		}
 
-			while(IsDigit(Peek()))
-				Advance();
+		// The lexeme is digits with at most one dot, which from_chars always accepts, whatever the locale.
+		auto lexeme = GetLexeme();
+		double value = 0;
+		auto result = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+
+		auto column = m_Current - m_LineStart + 1;
+		if(result.ec == std::errc::result_out_of_range)
+		{
+			m_Diagnostics.Error(absl::StrCat("Number literal ", std::string(lexeme), " is out of range"), m_Line,
+								column);
+		}
+		else if(value >= MaxExactInteger && lexeme.find('.') == std::string_view::npos)
+		{
+			auto rounded = FormatInteger(value);
+			auto digits = lexeme.substr(std::min(lexeme.find_first_not_of('0'), lexeme.size()));
+			if(digits != rounded)
+			{
+				m_Diagnostics.Warning(absl::StrCat("Integer literal ", std::string(lexeme),
+												   " is not exactly representable, it is rounded to ", rounded),
+									  m_Line, column);
+			}
 		}
 
-		AddToken(Token::ID::Number, GetLexemeSubstring());
+		m_Token.emplace(value, m_Line, column);
 	}
 
-	void Lexer::HandleIdentifier()
+	void Lexer::HandleString()
 	{
-		static std::map<std::string, Token::ID> keywords = {
-			// clang-format off
-            {"let", Token::ID::Let},
-            {"return", Token::ID::Return},
-            {"match", Token::ID::Match},
-            {"if", Token::ID::If},
-            {"else", Token::ID::Else},
-            {"true", Token::ID::True},
-            {"false", Token::ID::False},
-			// clang-format on
-		};
-
-		while(IsAlphaNumeric(Peek()))
-			Advance();
-
-		std::string lexeme = GetLexemeSubstring();
-
-		auto it = keywords.find(lexeme);
-		if(it != keywords.end())
+		bool valid = true;
+
+		// Only validates the escapes, Token::GetString decodes them once the parser needs the characters.
+		while(Peek() != '"' && !IsAtEnd())
 		{
-			AddToken(it->second);
+			char c = Advance();
+			if(c == '\n')
+			{
+				m_Line++;
+				m_LineStart = m_Current;
+			}
+			else if(c == '\\' && !IsAtEnd())
+			{
+				valid = Token::DecodeEscape(Advance()).has_value() && valid;
+			}
 		}
-		else
+
+		// Unterminated, or with an escape we don't know.
+		if(IsAtEnd() || !valid)
+		{
+			if(!IsAtEnd())
+			{
+				Advance();
+			}
+
+			AddToken(Token::ID::Unknown);
+			return;
+		}
+
+		Advance();
+		AddToken(Token::ID::String, m_Source.substr(m_Start + 1, m_Current - m_Start - 2));
+	}
+
+	void Lexer::HandleIdentifier()
+	{
+		m_Current = m_Kernels->SkipIdentifier(m_Source.data(), m_Current, m_Source.size());
+
+		AddToken(ClassifyIdentifier(GetLexeme()));
+	}
+
+	// The whole run at once, from the character that got us here. Only the newlines are looked at afterwards.
+	void Lexer::HandleWhitespace()
+	{
+		auto run = m_Kernels->SkipWhitespace(m_Source.data(), m_Start, m_Source.size());
+		if(run.Newlines)
 		{
-			AddToken(Token::ID::Identifier, lexeme);
+			m_Line += run.Newlines;
+			m_LineStart = run.LastNewline + 1;
 		}
+
+		m_Current = run.End;
 	}
 
-	void Lexer::AddToken(Token::ID token) { m_Tokens.emplace_back(token, "", m_Line, m_Column); }
+	void Lexer::AddToken(Token::ID token) { AddToken(token, GetLexeme()); }
 
-	void Lexer::AddToken(Token::ID token, const std::string& literal)
+	void Lexer::AddToken(Token::ID token, std::string_view lexeme)
 	{
-		m_Tokens.emplace_back(token, literal, m_Line, m_Column);
+		m_Token.emplace(token, lexeme, m_Line, m_Current - m_LineStart + 1);
 	}
 
 	bool Lexer::IsAtEnd() const { return m_Current >= m_Source.size(); }
@@ -144,7 +318,6 @@ namespace Glyph
 			return false;
 
 		m_Current++;
-		m_Column++;
 
 		return true;
 	}
@@ -152,7 +325,6 @@ namespace Glyph
 	char Lexer::Advance()
 	{
 		m_Current++;
-		m_Column++;
 
 		return m_Source[m_Current - 1];
 	}
@@ -173,12 +345,10 @@ namespace Glyph
 		return m_Source[m_Current + 1];
 	}
 
-	std::string Lexer::GetLexemeSubstring() const { return m_Source.substr(m_Start, m_Current - m_Start); }
+	std::string_view Lexer::GetLexeme() const { return m_Source.substr(m_Start, m_Current - m_Start); }
 
 	bool Lexer::IsDigit(char c) { return c >= '0' && c <= '9'; }
 
 	bool Lexer::IsAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
 
-	bool Lexer::IsAlphaNumeric(char c) { return IsAlpha(c) || IsDigit(c); }
-
 } // namespace Glyph
\ No newline at end of file
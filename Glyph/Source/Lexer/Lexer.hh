@@ -1,25 +1,41 @@
 #pragma once
 
+#include <Lexer/ScanKernels.hh>
+#include <Lexer/SourceFile.hh>
 #include <Lexer/Token.hh>
+#include <Parser/Diagnostics.hh>
 
-#include <string>
+#include <optional>
+#include <string_view>
 
 namespace Glyph
 {
+	/// @brief Splits source text into tokens. The text is borrowed, not copied, the tokens view into it.
 	class Lexer
 	{
 	  public:
-		Lexer(const std::string& input);
+		explicit Lexer(std::string_view source);
+		explicit Lexer(const SourceFile& file);
 
+		/// @brief Scans up to the next token and returns it, EOI once the text is exhausted and on every call after.
+		Token Next();
+
+		/// @brief Every token at once, EOI last. The Parser pulls them with Next instead, this is for tooling.
 		Tokens Scan();
 
+		/// @brief Number literals the lexer could not convert exactly.
+		const Diagnostics& GetDiagnostics() const { return m_Diagnostics; }
+
 	  private:
 		void ScanToken();
 		void HandleNumber();
 		void HandleIdentifier();
+		void HandleString();
+		void HandleWhitespace();
 
+		/// @brief Adds a token whose lexeme is everything scanned since m_Start.
 		void AddToken(Token::ID token);
-		void AddToken(Token::ID token, const std::string& literal);
+		void AddToken(Token::ID token, std::string_view lexeme);
 
 		bool IsAtEnd() const;
 		bool Match(char expected);
@@ -28,15 +44,19 @@ namespace Glyph
 		char Peek() const;
 		char PeekNext() const;
 
-		std::string GetLexemeSubstring() const;
+		std::string_view GetLexeme() const;
 
 		static bool IsDigit(char c);
 		static bool IsAlpha(char c);
-		static bool IsAlphaNumeric(char c);
 
 	  private:
-		std::size_t m_Start, m_Current, m_Line, m_Column;
-		std::string m_Source;
-		Tokens m_Tokens;
+		std::size_t m_Start, m_Current, m_Line;
+		/// @brief Offset of the first character of the current line, columns are counted from it when a token is added.
+		std::size_t m_LineStart;
+		std::string_view m_Source;
+		const ScanKernels* m_Kernels;
+		Diagnostics m_Diagnostics;
+		/// @brief The token the last ScanToken produced, if it produced one.
+		std::optional<Token> m_Token;
 	};
 } // namespace Glyph
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include <Lexer/ScanKernels.hh>
+
+#include <cstdint>
+
+// Same scheme as the vector kernels: the SIMD sets are compiled for their instruction set with target attributes and
+// only picked once the CPU reported it.
+#if !defined(GLYPH_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__))                                         \
+	&& (defined(__GNUC__) || defined(__clang__))
+#	define GLYPH_SIMD_X86 1
+#	include <immintrin.h>
+#else
+#	define GLYPH_SIMD_X86 0
+#endif
+
+namespace
+{
+	using Glyph::ScanKernels;
+	using Glyph::WhitespaceRun;
+
+	bool IsWhitespace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+	bool IsIdentifierChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+	bool IsNotNewline(char c) { return c != '\n'; }
+
+	template<bool (*InRun)(char)> std::size_t ScalarSkip(const char* text, std::size_t from, std::size_t size)
+	{
+		while(from < size && InRun(text[from]))
+		{
+			from++;
+		}
+
+		return from;
+	}
+
+	// The whole run for the scalar set, the tail shorter than a block for the others.
+	WhitespaceRun FinishWhitespace(WhitespaceRun run, const char* text, std::size_t from, std::size_t size)
+	{
+		for(; from < size && IsWhitespace(text[from]); from++)
+		{
+			if(text[from] == '\n')
+			{
+				run.Newlines++;
+				run.LastNewline = from;
+			}
+		}
+
+		run.End = from;
+
+		return run;
+	}
+
+	WhitespaceRun ScalarSkipWhitespace(const char* text, std::size_t from, std::size_t size)
+	{
+		return FinishWhitespace({from, 0, 0}, text, from, size);
+	}
+
+	constexpr ScanKernels ScalarKernels {
+		"scalar", ScalarSkipWhitespace, ScalarSkip<IsIdentifierChar>, ScalarSkip<IsDigit>, ScalarSkip<IsNotNewline>,
+	};
+
+#if GLYPH_SIMD_X86
+#	define GLYPH_TARGET(features) __attribute__((target(features)))
+
+	// newlines has a bit per newline of the block starting at from, all of them inside the run.
+	void AddNewlines(WhitespaceRun& run, uint32_t newlines, std::size_t from)
+	{
+		if(newlines)
+		{
+			run.Newlines += __builtin_popcount(newlines);
+			run.LastNewline = from + 31 - __builtin_clz(newlines);
+		}
+	}
+
+	// The masks have a bit per character of the block, set while it belongs to the run. Bytes compare signed, so
+	// anything from 0x80 up is negative and outside every range.
+	GLYPH_TARGET("sse2") __m128i Sse2InRange(__m128i c, char low, char high)
+	{
+		return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(low - 1)), _mm_cmpgt_epi8(_mm_set1_epi8(high + 1), c));
+	}
+
+	GLYPH_TARGET("sse2") uint32_t Sse2IdentifierMask(__m128i c)
+	{
+		// Setting bit 5 folds upper case onto lower case and moves no other character into a-z.
+		auto letter = Sse2InRange(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 'z');
+		auto digit = Sse2InRange(c, '0', '9');
+		auto underscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+
+		return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letter, digit), underscore));
+	}
+
+	GLYPH_TARGET("sse2") uint32_t Sse2DigitMask(__m128i c) { return _mm_movemask_epi8(Sse2InRange(c, '0', '9')); }
+
+	GLYPH_TARGET("sse2") uint32_t Sse2NotNewlineMask(__m128i c)
+	{
+		return ~_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n'))) & 0xFFFF;
+	}
+
+	template<uint32_t (*Mask)(__m128i), bool (*InRun)(char)>
+	GLYPH_TARGET("sse2") std::size_t Sse2Skip(const char* text, std::size_t from, std::size_t size)
+	{
+		for(; from + 16 <= size; from += 16)
+		{
+			uint32_t outside = ~Mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + from))) & 0xFFFF;
+			if(outside)
+			{
+				return from + __builtin_ctz(outside);
+			}
+		}
+
+		return ScalarSkip<InRun>(text, from, size);
+	}
+
+	GLYPH_TARGET("sse2") WhitespaceRun Sse2SkipWhitespace(const char* text, std::size_t from, std::size_t size)
+	{
+		WhitespaceRun run {from, 0, 0};
+		for(; from + 16 <= size; from += 16)
+		{
+			auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + from));
+			auto blank = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\t')));
+			blank = _mm_or_si128(blank, _mm_cmpeq_epi8(c, _mm_set1_epi8('\r')));
+
+			uint32_t newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')));
+			uint32_t outside = ~(newlines | _mm_movemask_epi8(blank)) & 0xFFFF;
+			if(outside)
+			{
+				AddNewlines(run, newlines & ((1u << __builtin_ctz(outside)) - 1), from);
+				run.End = from + __builtin_ctz(outside);
+				return run;
+			}
+
+			AddNewlines(run, newlines, from);
+		}
+
+		return FinishWhitespace(run, text, from, size);
+	}
+
+	constexpr ScanKernels Sse2Kernels {
+		"sse2",
+		Sse2SkipWhitespace,
+		Sse2Skip<Sse2IdentifierMask, IsIdentifierChar>,
+		Sse2Skip<Sse2DigitMask, IsDigit>,
+		Sse2Skip<Sse2NotNewlineMask, IsNotNewline>,
+	};
+
+	GLYPH_TARGET("avx2") __m256i Avx2InRange(__m256i c, char low, char high)
+	{
+		return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(low - 1)),
+								_mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), c));
+	}
+
+	GLYPH_TARGET("avx2") uint32_t Avx2IdentifierMask(__m256i c)
+	{
+		auto letter = Avx2InRange(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), 'a', 'z');
+		auto digit = Avx2InRange(c, '0', '9');
+		auto underscore = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_'));
+
+		return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(letter, digit), underscore));
+	}
+
+	GLYPH_TARGET("avx2") uint32_t Avx2DigitMask(__m256i c) { return _mm256_movemask_epi8(Avx2InRange(c, '0', '9')); }
+
+	GLYPH_TARGET("avx2") uint32_t Avx2NotNewlineMask(__m256i c)
+	{
+		return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n'))));
+	}
+
+	template<uint32_t (*Mask)(__m256i), bool (*InRun)(char)>
+	GLYPH_TARGET("avx2") std::size_t Avx2Skip(const char* text, std::size_t from, std::size_t size)
+	{
+		for(; from + 32 <= size; from += 32)
+		{
+			uint32_t outside = ~Mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + from)));
+			if(outside)
+			{
+				return from + __builtin_ctz(outside);
+			}
+		}
+
+		return ScalarSkip<InRun>(text, from, size);
+	}
+
+	GLYPH_TARGET("avx2") WhitespaceRun Avx2SkipWhitespace(const char* text, std::size_t from, std::size_t size)
+	{
+		WhitespaceRun run {from, 0, 0};
+		for(; from + 32 <= size; from += 32)
+		{
+			auto c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + from));
+			auto blank =
+				_mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t')));
+			blank = _mm256_or_si256(blank, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r')));
+
+			uint32_t newlines = _mm256_movemask_epi8(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')));
+			uint32_t outside = ~(newlines | static_cast<uint32_t>(_mm256_movemask_epi8(blank)));
+			if(outside)
+			{
+				AddNewlines(run, newlines & ((1u << __builtin_ctz(outside)) - 1), from);
+				run.End = from + __builtin_ctz(outside);
+				return run;
+			}
+
+			AddNewlines(run, newlines, from);
+		}
+
+		return FinishWhitespace(run, text, from, size);
+	}
+
+	constexpr ScanKernels Avx2Kernels {
+		"avx2",
+		Avx2SkipWhitespace,
+		Avx2Skip<Avx2IdentifierMask, IsIdentifierChar>,
+		Avx2Skip<Avx2DigitMask, IsDigit>,
+		Avx2Skip<Avx2NotNewlineMask, IsNotNewline>,
+	};
+
+#	undef GLYPH_TARGET
+#endif
+
+	const ScanKernels& SelectKernels()
+	{
+#if GLYPH_SIMD_X86
+		__builtin_cpu_init();
+
+		if(__builtin_cpu_supports("avx2"))
+		{
+			return Avx2Kernels;
+		}
+
+		if(__builtin_cpu_supports("sse2"))
+		{
+			return Sse2Kernels;
+		}
+#endif
+
+		return ScalarKernels;
+	}
+} // namespace
+
+namespace Glyph
+{
+	const ScanKernels& GetScanKernels()
+	{
+		static const ScanKernels& kernels = SelectKernels();
+
+		return kernels;
+	}
+} // namespace Glyph
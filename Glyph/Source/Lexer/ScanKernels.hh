@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Glyph
+{
+	/// @brief Where a whitespace run ends, and the newlines in it the lexer needs for line and column.
+	struct WhitespaceRun
+	{
+		std::size_t End;
+		std::size_t Newlines;
+		/// @brief Offset of the last newline of the run, meaningless without any.
+		std::size_t LastNewline;
+	};
+
+	/// @brief Loops finding the end of a run of one class of characters, one set per instruction set. Each takes the
+	/// offset to start at and returns the offset of the first character outside the run, size when the run reaches
+	/// the end. The SIMD sets test 16 or 32 characters at a time and never read past size.
+	struct ScanKernels
+	{
+		const char* Name;
+
+		/// @brief Spaces, tabs, carriage returns and newlines.
+		WhitespaceRun (*SkipWhitespace)(const char* text, std::size_t from, std::size_t size);
+		/// @brief [a-zA-Z0-9_]
+		std::size_t (*SkipIdentifier)(const char* text, std::size_t from, std::size_t size);
+		/// @brief [0-9]
+		std::size_t (*SkipDigits)(const char* text, std::size_t from, std::size_t size);
+		/// @brief Anything but a newline, the body of a comment.
+		std::size_t (*SkipLine)(const char* text, std::size_t from, std::size_t size);
+	};
+
+	/// @brief The widest set the CPU supports, detected on first use. Building with GLYPH_DISABLE_SIMD leaves only
+	/// the scalar one.
+	const ScanKernels& GetScanKernels();
+} // namespace Glyph
@@ -0,0 +1,12 @@
+#include <Lexer/SourceFile.hh>
+
+#include <utility>
+
+namespace Glyph
+{
+	SourceFile::SourceFile(std::string name, std::string text)
+		: m_Name(std::move(name))
+		, m_Text(std::move(text))
+	{
+	}
+} // namespace Glyph
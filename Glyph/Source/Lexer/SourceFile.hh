@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Glyph
+{
+	/// @brief Owns the text of a program once. The Lexer borrows it and tokens view into it, so it stays put: it can
+	/// be neither copied nor moved, and has to outlive the tokens scanned from it.
+	class SourceFile
+	{
+	  public:
+		SourceFile(std::string name, std::string text);
+
+		SourceFile(const SourceFile&) = delete;
+		SourceFile& operator=(const SourceFile&) = delete;
+
+		[[nodiscard]] const std::string& GetName() const { return m_Name; }
+		[[nodiscard]] std::string_view GetText() const { return m_Text; }
+
+	  private:
+		std::string m_Name;
+		std::string m_Text;
+	};
+} // namespace Glyph
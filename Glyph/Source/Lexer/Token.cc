@@ -2,6 +2,44 @@
 
 #include <magic_enum/magic_enum.hpp>
 
+namespace Glyph
+{
+	std::string Token::GetString() const
+	{
+		auto lexeme = GetLexeme();
+
+		std::string value;
+		value.reserve(lexeme.size());
+		for(std::size_t i = 0; i < lexeme.size(); i++)
+		{
+			if(lexeme[i] == '\\' && i + 1 < lexeme.size())
+			{
+				value += DecodeEscape(lexeme[++i]).value_or('\\');
+			}
+			else
+			{
+				value += lexeme[i];
+			}
+		}
+
+		return value;
+	}
+
+	std::optional<char> Token::DecodeEscape(char c)
+	{
+		switch(c)
+		{
+			case 'n': return '\n';
+			case 't': return '\t';
+			case 'r': return '\r';
+			case '0': return '\0';
+			case '\\': return '\\';
+			case '"': return '"';
+			default: return std::nullopt;
+		}
+	}
+} // namespace Glyph
+
 std::ostream& operator<<(std::ostream& out, const Glyph::Token& token)
 {
 	out << "Token(" << magic_enum::enum_name(token.GetID()) << ", ";
@@ -1,15 +1,22 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace Glyph
 {
+	/// @brief A token is a plain value: its lexeme is a view into the source text the Lexer read, so scanning
+	/// allocates nothing per token. The text has to outlive every token and whatever still reads their lexemes.
+	/// Number tokens have no lexeme, the Lexer converts them once and they carry the value instead.
 	class Token
 	{
 	  public:
-		enum class ID
+		enum class ID : uint8_t
 		{
 			// End of file
 			EOI,
@@ -20,10 +27,12 @@ namespace Glyph
 			Match,	// match
 			If,		// if
 			Else,	// else
+			In,		// in
 
 			// Literals
 			Identifier, // [a-zA-Z_][a-zA-Z0-9_]*
-			Number,		// [0-9]+
+			Number,		// [0-9]+(\.[0-9]+)?
+			String,		// "..." with \n \t \r \0 \\ \" escapes, the lexeme is the text between the quotes
 			True,		// true
 			False,		// false
 
@@ -46,8 +55,11 @@ namespace Glyph
 			RightParen,	  // )
 			LeftBrace,	  // {
 			RightBrace,	  // }
+			LeftBracket,  // [
+			RightBracket, // ]
 			Comma,		  // ,
 			Semicolon,	  // ;
+			Colon,		  // :
 			Arrow,		  // ->
 			Dot,		  // .
 
@@ -56,29 +68,56 @@ namespace Glyph
 		};
 
 	  public:
-		Token(ID id, const std::string& lexeme, std::size_t line, std::size_t column)
+		constexpr Token(ID id, std::string_view lexeme, std::size_t line, std::size_t column)
 			: m_id(id)
-			, lexeme(lexeme)
-			, line(line)
-			, column(column)
+			, m_lexeme(lexeme.data())
+			, m_length(static_cast<uint32_t>(lexeme.size()))
+			, m_line(static_cast<uint32_t>(line))
+			, m_column(static_cast<uint32_t>(column))
 		{
 		}
 
-		Token() = default;
+		constexpr Token(double number, std::size_t line, std::size_t column)
+			: m_id(ID::Number)
+			, m_number(number)
+			, m_line(static_cast<uint32_t>(line))
+			, m_column(static_cast<uint32_t>(column))
+		{
+		}
+
+		constexpr Token() = default;
 
 		ID GetID() const { return m_id; }
-		const std::string& GetLexeme() const { return lexeme; }
-		std::size_t GetLine() const { return line; }
-		std::size_t GetColumn() const { return column; }
+		std::string_view GetLexeme() const { return m_id == ID::Number ? std::string_view {} : GetText(); }
+		std::size_t GetLine() const { return m_line; }
+		std::size_t GetColumn() const { return m_column; }
+
+		double GetNumber() const { return m_number; }
+
+		/// @brief The characters of a String token with its escapes decoded. The lexer only emits strings whose
+		/// escapes are all valid.
+		std::string GetString() const;
 
-		double GetNumber() const { return std::stod(lexeme); }
+		/// @brief The character the escape sequence \c stands for, nullopt for an unknown escape.
+		static std::optional<char> DecodeEscape(char c);
 
 	  private:
-		ID m_id;
-		std::string lexeme;
-		std::size_t line, column;
+		std::string_view GetText() const { return {m_lexeme, m_length}; }
+
+	  private:
+		ID m_id {ID::EOI};
+		union
+		{
+			const char* m_lexeme {nullptr};
+			double m_number;
+		};
+		uint32_t m_length {0};
+		uint32_t m_line {0};
+		uint32_t m_column {0};
 	};
 
+	static_assert(std::is_trivially_copyable_v<Token>);
+
 	using Tokens = std::vector<Token>;
 
 } // namespace Glyph
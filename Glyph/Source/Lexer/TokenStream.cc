@@ -0,0 +1,53 @@
+#include <Lexer/TokenStream.hh>
+
+#include <utility>
+
+namespace Glyph
+{
+	TokenStream::TokenStream(Lexer& lexer)
+		: m_Lexer(&lexer)
+	{
+	}
+
+	TokenStream::TokenStream(Tokens tokens)
+		: m_Tokens(std::move(tokens))
+	{
+	}
+
+	const Token& TokenStream::Peek(std::size_t offset)
+	{
+		while(m_Count <= offset)
+		{
+			m_Window[(m_Head + m_Count) & Mask] = Pull();
+			m_Count++;
+		}
+
+		return m_Window[(m_Head + offset) & Mask];
+	}
+
+	const Token& TokenStream::Advance()
+	{
+		if(Peek().GetID() != Token::ID::EOI)
+		{
+			m_Head = (m_Head + 1) & Mask;
+			m_Count--;
+		}
+
+		return Previous();
+	}
+
+	Token TokenStream::Pull()
+	{
+		if(m_Lexer)
+		{
+			return m_Lexer->Next();
+		}
+
+		if(m_Next < m_Tokens.size())
+		{
+			return m_Tokens[m_Next++];
+		}
+
+		return {Token::ID::EOI, "", 0, 0};
+	}
+} // namespace Glyph
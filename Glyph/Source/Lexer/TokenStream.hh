@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Lexer/Lexer.hh>
+#include <Lexer/Token.hh>
+
+#include <array>
+#include <cstddef>
+
+namespace Glyph
+{
+	/// @brief The parser's window on the tokens: the last one consumed and up to Lookahead ahead of it, in a ring
+	/// buffer. Tokens are pulled from a Lexer as the window moves, so the whole program is never held as tokens. A
+	/// scanned Tokens vector can be read the same way.
+	class TokenStream
+	{
+	  public:
+		static constexpr std::size_t Lookahead = 3;
+
+		/// @brief Borrows the lexer, which has to outlive the stream.
+		explicit TokenStream(Lexer& lexer);
+		explicit TokenStream(Tokens tokens);
+
+		/// @brief The token offset places after the current one, offset has to be below Lookahead. EOI past the end.
+		const Token& Peek(std::size_t offset = 0);
+
+		/// @brief Consumes the current token, unless it is EOI, and returns the last one consumed.
+		const Token& Advance();
+
+		/// @brief The last token consumed, an empty EOI before the first.
+		const Token& Previous() const { return m_Window[(m_Head - 1) & Mask]; }
+
+	  private:
+		Token Pull();
+
+	  private:
+		// One slot more than the lookahead keeps the previous token, a power of two makes the wrap a mask.
+		static constexpr std::size_t Capacity = 4;
+		static constexpr std::size_t Mask = Capacity - 1;
+		static_assert(Capacity > Lookahead && (Capacity & Mask) == 0);
+
+		std::array<Token, Capacity> m_Window {};
+		std::size_t m_Head {0};
+		std::size_t m_Count {0};
+
+		Lexer* m_Lexer {nullptr};
+		Tokens m_Tokens;
+		std::size_t m_Next {0};
+	};
+} // namespace Glyph
@@ -4,24 +4,39 @@ namespace Glyph
 {
 	void Diagnostics::Error(const std::string& message, int line, int column)
 	{
-		m_Errors.push_back({message, line, column});
+		m_Diagnostics.push_back({Severity::Error, message, line, column});
+		m_ErrorCount++;
 	}
 
 	void Diagnostics::Warning(const std::string& message, int line, int column)
 	{
-		m_Errors.push_back({message, line, column});
+		m_Diagnostics.push_back({Severity::Warning, message, line, column});
 	}
 
 	void Diagnostics::Info(const std::string& message, int line, int column)
 	{
-		m_Errors.push_back({message, line, column});
+		m_Diagnostics.push_back({Severity::Info, message, line, column});
 	}
 
 	void Diagnostics::ForEachError(const std::function<void(const std::string&, int, int)>& callback) const
 	{
-		for(const auto& error : m_Errors)
+		ForEach(Severity::Error, callback);
+	}
+
+	void Diagnostics::ForEachWarning(const std::function<void(const std::string&, int, int)>& callback) const
+	{
+		ForEach(Severity::Warning, callback);
+	}
+
+	void Diagnostics::ForEach(Severity severity,
+							  const std::function<void(const std::string&, int, int)>& callback) const
+	{
+		for(const auto& diagnostic : m_Diagnostics)
 		{
-			callback(error.message, error.line, error.column);
+			if(diagnostic.severity == severity)
+			{
+				callback(diagnostic.message, diagnostic.line, diagnostic.column);
+			}
 		}
 	}
 } // namespace Glyph
\ No newline at end of file
@@ -17,17 +17,30 @@ namespace Glyph
 		void Info(const std::string& message, int line, int column);
 
 		void ForEachError(const std::function<void(const std::string&, int, int)>& callback) const;
+		void ForEachWarning(const std::function<void(const std::string&, int, int)>& callback) const;
 
-		bool HasErrors() const { return !m_Errors.empty(); }
+		/// @brief Warnings and infos don't count, they don't stop compilation.
+		bool HasErrors() const { return m_ErrorCount != 0; }
 
 	  private:
+		enum class Severity
+		{
+			Error,
+			Warning,
+			Info
+		};
+
 		struct Diagnostic
 		{
+			Severity severity;
 			std::string message;
 			int line;
 			int column;
 		};
 
-		std::vector<Diagnostic> m_Errors;
+		void ForEach(Severity severity, const std::function<void(const std::string&, int, int)>& callback) const;
+
+		std::vector<Diagnostic> m_Diagnostics;
+		std::size_t m_ErrorCount {0};
 	};
 } // namespace Glyph
\ No newline at end of file
@@ -10,10 +10,15 @@
 
 namespace Glyph
 {
+	Parser::Parser(Lexer& lexer)
+		: m_Diagnostics()
+		, m_Tokens(lexer)
+	{
+	}
+
 	Parser::Parser(Tokens tokens)
 		: m_Diagnostics()
 		, m_Tokens(std::move(tokens))
-		, m_Current(0)
 	{
 	}
 
@@ -119,13 +124,14 @@ namespace Glyph
 
 			if(CheckToken(Token::ID::LeftParen))
 			{
-				return ParseCall(id);
+				return ParsePostfix(ParseCall(id));
 			}
 
-			return id;
+			return ParsePostfix(id);
 		}
 
-		if(CheckToken(Token::ID::Number) || CheckToken(Token::ID::True) || CheckToken(Token::ID::False))
+		if(CheckToken(Token::ID::Number) || CheckToken(Token::ID::String) || CheckToken(Token::ID::True)
+		   || CheckToken(Token::ID::False))
 		{
 			return ParseLiteral();
 		}
@@ -142,9 +148,26 @@ namespace Glyph
 
 		if(CheckToken(Token::ID::LeftBrace))
 		{
+			// No statement starts with 'name:', so that is a record and anything else a block.
+			if(PeekToken(1).GetID() == Token::ID::Identifier && PeekToken(2).GetID() == Token::ID::Colon)
+			{
+				return ParsePostfix(ParseRecord());
+			}
+
 			return ParseBlock();
 		}
 
+		if(CheckToken(Token::ID::LeftBracket))
+		{
+			return ParsePostfix(ParseCollection());
+		}
+
+		// There are no parenthesized expressions, a '(' can only start a lambda.
+		if(CheckToken(Token::ID::LeftParen))
+		{
+			return ParseLambda();
+		}
+
 		ReportError("Primary - Unexpected token");
 
 		return nullptr;
@@ -163,7 +186,7 @@ namespace Glyph
 
 			AdvanceToken();
 
-			auto op = CreateASTNode<OperatorNode>(token.GetLexeme());
+			auto op = CreateASTNode<OperatorNode>(GetOperator(token.GetID()));
 			auto rhs = ParsePrimary();
 
 			while(true)
@@ -172,7 +195,12 @@ namespace Glyph
 
 				if(GetPrecedence(nextToken.GetID()) > GetPrecedence(token.GetID()))
 				{
-					rhs = ParseBinary(rhs, GetPrecedence(nextToken.GetID()));
+					rhs = ParseBinary(rhs, GetPrecedence(token.GetID()));
+				}
+				else if(nextToken.GetID() == Token::ID::Equal && token.GetID() == Token::ID::Equal)
+				{
+					// Assignment is right associative, a = b = c assigns c to b first.
+					rhs = ParseBinary(rhs, GetPrecedence(token.GetID()) - 1);
 				}
 				else
 				{
@@ -275,7 +303,7 @@ namespace Glyph
 	{
 		auto token = Consume(Token::ID::Identifier);
 
-		return CreateASTNode<IdentifierNode>(token.GetLexeme());
+		return CreateASTNode<IdentifierNode>(std::string(token.GetLexeme()));
 	}
 
 	LiteralNodePtr Parser::ParseLiteral()
@@ -284,7 +312,12 @@ namespace Glyph
 
 		if(token.GetID() == Token::ID::Number)
 		{
-			return CreateASTNode<LiteralNode>(std::stod(token.GetLexeme()));
+			return CreateASTNode<LiteralNode>(token.GetNumber());
+		}
+
+		if(token.GetID() == Token::ID::String)
+		{
+			return CreateASTNode<LiteralNode>(token.GetString());
 		}
 
 		if(token.GetID() == Token::ID::True)
@@ -302,7 +335,126 @@ namespace Glyph
 		return nullptr;
 	}
 
+	ExpressionNodePtr Parser::ParseCollection()
+	{
+		Consume(Token::ID::LeftBracket);
+
+		// '[:]' is the empty dict and '[]' the empty array, otherwise a ':' after the first element makes a dict.
+		if(CheckToken(Token::ID::Colon))
+		{
+			AdvanceToken();
+			Consume(Token::ID::RightBracket, "Expected ']' after '[:'");
+
+			return CreateASTNode<DictLiteralNode>(std::vector<DictLiteralNode::Entry> {});
+		}
+
+		if(CheckToken(Token::ID::RightBracket))
+		{
+			AdvanceToken();
+
+			return CreateASTNode<ArrayLiteralNode>(std::vector<ExpressionNodePtr> {});
+		}
+
+		auto first = ParseExpression();
+		if(!CheckToken(Token::ID::Colon))
+		{
+			std::vector<ExpressionNodePtr> elements {first};
+			while(CheckToken(Token::ID::Comma))
+			{
+				AdvanceToken();
+				elements.push_back(ParseExpression());
+			}
+
+			Consume(Token::ID::RightBracket, "Expected ']' after array elements");
+
+			return CreateASTNode<ArrayLiteralNode>(elements);
+		}
+
+		std::vector<DictLiteralNode::Entry> entries;
+
+		auto key = first;
+		while(true)
+		{
+			Consume(Token::ID::Colon, "Expected ':' after dict key");
+			entries.emplace_back(key, ParseExpression());
+
+			if(!CheckToken(Token::ID::Comma))
+			{
+				break;
+			}
+
+			AdvanceToken();
+			key = ParseExpression();
+		}
+
+		Consume(Token::ID::RightBracket, "Expected ']' after dict entries");
+
+		return CreateASTNode<DictLiteralNode>(entries);
+	}
+
+	RecordLiteralNodePtr Parser::ParseRecord()
+	{
+		Consume(Token::ID::LeftBrace);
+
+		std::vector<RecordLiteralNode::Field> fields;
+		while(true)
+		{
+			auto name = std::string(Consume(Token::ID::Identifier, "Expected a field name").GetLexeme());
+			Consume(Token::ID::Colon, "Expected ':' after field name");
+			fields.emplace_back(name, ParseExpression());
+
+			if(!CheckToken(Token::ID::Comma))
+			{
+				break;
+			}
+
+			AdvanceToken();
+		}
+
+		Consume(Token::ID::RightBrace, "Expected '}' after record fields");
+
+		return CreateASTNode<RecordLiteralNode>(fields);
+	}
+
+	ExpressionNodePtr Parser::ParsePostfix(ExpressionNodePtr object)
+	{
+		while(CheckToken(Token::ID::LeftBracket) || CheckToken(Token::ID::Dot))
+		{
+			if(AdvanceToken().GetID() == Token::ID::Dot)
+			{
+				auto name = Consume(Token::ID::Identifier, "Expected a field name after '.'").GetLexeme();
+				object = CreateASTNode<FieldExpressionNode>(object, std::string(name));
+
+				continue;
+			}
+
+			auto key = ParseExpression();
+			Consume(Token::ID::RightBracket, "Expected ']' after index");
+
+			object = CreateASTNode<IndexExpressionNode>(object, key);
+		}
+
+		return object;
+	}
+
 	PrototypeNodePtr Parser::ParsePrototype(IdentifierNodePtr name)
+	{
+		auto args = ParseParameters();
+
+		return CreateASTNode<PrototypeNode>(name, args);
+	}
+
+	LambdaExpressionNodePtr Parser::ParseLambda()
+	{
+		auto args = ParseParameters();
+		Consume(Token::ID::Arrow, "Expected '->' after lambda arguments");
+
+		auto block = ParseBlock();
+
+		return CreateASTNode<LambdaExpressionNode>(args, block);
+	}
+
+	std::vector<std::string> Parser::ParseParameters()
 	{
 		std::vector<std::string> args;
 
@@ -313,7 +465,7 @@ namespace Glyph
 			while(!CheckToken(Token::ID::RightParen))
 			{
 				auto arg = Consume(Token::ID::Identifier).GetLexeme();
-				args.push_back(arg);
+				args.emplace_back(arg);
 
 				if(CheckToken(Token::ID::Comma))
 				{
@@ -324,61 +476,68 @@ namespace Glyph
 
 		Consume(Token::ID::RightParen);
 
-		return CreateASTNode<PrototypeNode>(name, args);
+		return args;
 	}
 
 	int Parser::GetPrecedence(Token::ID token) const
 	{
 		switch(token)
 		{
-			case Token::ID::Plus:
-			case Token::ID::Minus: return 1;
-			case Token::ID::Asterisk:
-			case Token::ID::Slash: return 2;
-			case Token::ID::Equal:
+			case Token::ID::Equal: return 1;
+			case Token::ID::Or: return 2;
+			case Token::ID::And: return 3;
 			case Token::ID::EqualEqual:
 			case Token::ID::BangEqual:
 			case Token::ID::Less:
 			case Token::ID::LessEqual:
 			case Token::ID::Greater:
-			case Token::ID::GreaterEqual: return 3;
-			case Token::ID::And:
-			case Token::ID::Or: return 4;
+			case Token::ID::GreaterEqual:
+			case Token::ID::In: return 4;
+			case Token::ID::Plus:
+			case Token::ID::Minus: return 5;
+			case Token::ID::Asterisk:
+			case Token::ID::Slash: return 6;
 			default: return 0;
 		}
 	}
 
-	bool Parser::CheckToken(Token::ID token) const
+	OperatorNode::Operator Parser::GetOperator(Token::ID token)
 	{
-		if(IsAtEnd())
+		switch(token)
 		{
-			return false;
+			case Token::ID::Plus: return OperatorNode::Operator::Plus;
+			case Token::ID::Minus: return OperatorNode::Operator::Minus;
+			case Token::ID::Asterisk: return OperatorNode::Operator::Star;
+			case Token::ID::Slash: return OperatorNode::Operator::Slash;
+			case Token::ID::Less: return OperatorNode::Operator::Less;
+			case Token::ID::Greater: return OperatorNode::Operator::Greater;
+			case Token::ID::EqualEqual: return OperatorNode::Operator::Equal;
+			case Token::ID::BangEqual: return OperatorNode::Operator::NotEqual;
+			case Token::ID::LessEqual: return OperatorNode::Operator::LessEqual;
+			case Token::ID::GreaterEqual: return OperatorNode::Operator::GreaterEqual;
+			case Token::ID::And: return OperatorNode::Operator::And;
+			case Token::ID::Or: return OperatorNode::Operator::Or;
+			case Token::ID::In: return OperatorNode::Operator::In;
+			case Token::ID::Equal: return OperatorNode::Operator::Assign;
+			default: ReportError("Binary - Unsupported operator"); throw std::runtime_error("Unsupported operator");
 		}
-
-		return PeekToken().GetID() == token;
 	}
 
-	Token Parser::PeekToken() const
+	bool Parser::CheckToken(Token::ID token)
 	{
 		if(IsAtEnd())
 		{
-			return {Token::ID::EOI, "", 0, 0};
+			return false;
 		}
 
-		return m_Tokens[m_Current];
+		return PeekToken().GetID() == token;
 	}
 
-	Token Parser::AdvanceToken()
-	{
-		if(!IsAtEnd())
-		{
-			m_Current++;
-		}
+	Token Parser::PeekToken(std::size_t offset) { return m_Tokens.Peek(offset); }
 
-		return m_Tokens[m_Current - 1];
-	}
+	Token Parser::AdvanceToken() { return m_Tokens.Advance(); }
 
-	Token Parser::GetToken() const { return m_Tokens[m_Current - 1]; }
+	Token Parser::GetToken() const { return m_Tokens.Previous(); }
 
 	Token Parser::Consume(Token::ID token, const std::string& message)
 	{
@@ -396,10 +555,7 @@ namespace Glyph
 		throw std::runtime_error("Expected token");
 	}
 
-	bool Parser::IsAtEnd() const
-	{
-		return m_Current >= m_Tokens.size() || m_Tokens[m_Current].GetID() == Token::ID::EOI;
-	}
+	bool Parser::IsAtEnd() { return m_Tokens.Peek().GetID() == Token::ID::EOI; }
 
 	void Parser::ReportError(const std::string& message)
 	{
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <AST/AST.hh>
+#include <Lexer/Lexer.hh>
 #include <Lexer/Token.hh>
+#include <Lexer/TokenStream.hh>
 #include <Parser/Diagnostics.hh>
 
 namespace Glyph
@@ -9,6 +11,8 @@ namespace Glyph
 	class Parser
 	{
 	  public:
+		/// @brief Pulls the tokens from the lexer while parsing, the lexer has to outlive the parser.
+		explicit Parser(Lexer& lexer);
 		Parser(Tokens tokens);
 
 		ProgramNodePtr ParseProgram();
@@ -30,17 +34,24 @@ namespace Glyph
 		BlockNodePtr ParseBlock();
 		IdentifierNodePtr ParseIdentifier();
 		LiteralNodePtr ParseLiteral();
+		ExpressionNodePtr ParseCollection();
+		RecordLiteralNodePtr ParseRecord();
+		ExpressionNodePtr ParsePostfix(ExpressionNodePtr object);
 
 		PrototypeNodePtr ParsePrototype(IdentifierNodePtr name);
+		LambdaExpressionNodePtr ParseLambda();
+		std::vector<std::string> ParseParameters();
 
 	  private:
 		int GetPrecedence(Token::ID token) const;
-		bool CheckToken(Token::ID token) const;
-		Token PeekToken() const;
+		OperatorNode::Operator GetOperator(Token::ID token);
+		bool CheckToken(Token::ID token);
+		/// @brief offset has to be below TokenStream::Lookahead.
+		Token PeekToken(std::size_t offset = 0);
 		Token AdvanceToken();
 		Token GetToken() const;
 		Token Consume(Token::ID token, const std::string& message = "");
-		bool IsAtEnd() const;
+		bool IsAtEnd();
 
 		void ReportError(const std::string& message);
 
@@ -58,7 +69,6 @@ namespace Glyph
 
 	  private:
 		Diagnostics m_Diagnostics;
-		Tokens m_Tokens;
-		std::size_t m_Current;
+		TokenStream m_Tokens;
 	};
 } // namespace Glyph
\ No newline at end of file
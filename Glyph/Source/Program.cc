@@ -1,6 +1,9 @@
 #include <AST/AST.hh>
 #include <Bytecode/BytecodeCompilerVisitor.hh>
 #include <Bytecode/BytecodeInstruction.hh>
+#include <Bytecode/BytecodeSizeEstimator.hh>
+#include <Bytecode/BytecodeVerifier.hh>
+#include <Bytecode/VM.hh>
 #include <Lexer/Lexer.hh>
 #include <Macros.hh>
 #include <Parser/Parser.hh>
@@ -13,6 +16,26 @@
 
 using namespace Glyph;
 
+// Prints the warnings and errors of one stage, returns whether it had errors.
+bool ReportDiagnostics(const char* stage, const Diagnostics& diagnostics)
+{
+	diagnostics.ForEachWarning([stage](auto& message, auto line, auto column) {
+		std::cerr << "[" << stage << "] Warning: " << message << " at " << line << ":" << column << std::endl;
+	});
+
+	if(!diagnostics.HasErrors())
+	{
+		return false;
+	}
+
+	std::cerr << "[" << stage << "] Errors" << std::endl;
+	diagnostics.ForEachError([](auto& message, auto line, auto column) {
+		std::cerr << "Error: " << message << " at " << line << ":" << column << std::endl;
+	});
+
+	return true;
+}
+
 void TestASTPrinterVisitor(void)
 {
 	// clang-format off
@@ -86,6 +109,10 @@ match 5+5 {
 
 	Lexer lexer(input);
 	auto tokens = lexer.Scan();
+	if(ReportDiagnostics("Lexer", lexer.GetDiagnostics()))
+	{
+		return;
+	}
 
 	for(const auto& token : tokens)
 	{
@@ -95,14 +122,8 @@ match 5+5 {
 	Parser parser(tokens);
 	auto program = parser.ParseProgram();
 
-	auto diagnostics = parser.GetDiagnostics();
-	if(diagnostics.HasErrors())
+	if(ReportDiagnostics("Parser", parser.GetDiagnostics()))
 	{
-		std::cerr << "[Parser] Errors" << std::endl;
-		diagnostics.ForEachError([](auto& message, auto line, auto column) {
-			std::cerr << "Error: " << message << " at " << line << ":" << column << std::endl;
-		});
-
 		return;
 	}
 
@@ -125,79 +146,52 @@ absl::Status TestBytecode(void)
     a + b;
     )";
 
-	// Load Constant Integer 10
-	// Store Local 'a'
-	// Load Constant Integer 20
-	// Store Local 'b'
-	// Load Local 'a'
-	// Load Local 'b'
+	// Load Constant 10
+	// Store Global 'a'
+	// Load Constant 20
+	// Store Global 'b'
+	// Load Global 'a'
+	// Load Global 'b'
 	// Add Operation
-	// Return
+	// End
 
+	// The parser pulls the tokens, the lexer is done once the program is parsed.
 	Lexer lexer(input);
-	auto tokens = lexer.Scan();
-
-	Parser parser(tokens);
+	Parser parser(lexer);
 	auto program = parser.ParseProgram();
 
-	auto diagnostics = parser.GetDiagnostics();
-	if(diagnostics.HasErrors())
+	if(ReportDiagnostics("Lexer", lexer.GetDiagnostics()) || ReportDiagnostics("Parser", parser.GetDiagnostics()))
 	{
-		std::cerr << "[Parser] Errors" << std::endl;
-		diagnostics.ForEachError([](auto& message, auto line, auto column) {
-			std::cerr << "Error: " << message << " at " << line << ":" << column << std::endl;
-		});
-
 		return absl::OkStatus();
 	}
 
 	using namespace Bytecode;
 
 	BytecodeCompiler compiler {};
+	compiler.Reserve(BytecodeSizeEstimator::Estimate(*program));
+
 	BytecodeCompilerVisitor visitor(std::cout);
 	if(auto result = visitor.Visit(compiler, *program); !result.ok())
 	{
 		std::cout << "Bytecode Compiler Error: " << result.Status << std::endl;
 
 		astVisitor.Visit(const_cast<AstNode&>(*result.Node));
+
+		return absl::OkStatus();
 	}
 
 	TRY(compiler.Emit<EndInstruction>());
 
-	int programCounter = 0;
-	auto* bytecode = compiler.m_Chunk.Bytecode();
+	auto chunk = compiler.Seal();
+	TRY(BytecodeVerifier::Verify(chunk));
 
-#define NEXT(instr) programCounter += sizeof(instr);
-	auto i = new EndInstruction();
-	while(true)
-	{
-		auto opcode = static_cast<Opcode>(bytecode[programCounter]);
-
-		switch(opcode)
-		{
-			case Opcode::LOAD_CONST:
-				{
-					auto& instruction = *reinterpret_cast<LoadConstInstruction*>(&bytecode[programCounter]);
-					auto constant = TRY_RET(compiler.m_Chunk.GetConstantTable().GetValue(instruction.Index()));
-
-					std::cout << instruction.ToString() << " " << constant->ToString() << std::endl;
+	chunk.Disassemble(std::cout);
+	std::cout << chunk.InstructionCount() << " instructions, " << chunk.BytecodeSize() << " bytes" << std::endl;
 
-					NEXT(LoadConstInstruction);
-				}
-				break;
-			case Opcode::END:
-				{
-					auto& instruction = *reinterpret_cast<EndInstruction*>(&bytecode[programCounter]);
+	VM vm;
+	auto value = TRY_RET(vm.Run(chunk));
 
-					std::cout << instruction.ToString() << std::endl;
-
-					goto end;
-				}
-
-			default: std::cerr << "Opcode not implemented: " << magic_enum::enum_name(opcode) << std::endl;
-		}
-	}
-end:
+	std::cout << "Result: " << value.ToString() << std::endl;
 
 	return absl::OkStatus();
 }
@@ -0,0 +1,11 @@
+#include <Runtime/ClosureObject.hh>
+
+namespace Glyph
+{
+	ClosureObject::ClosureObject(const FunctionObject* function)
+		: Object(ObjectType::Closure)
+		, m_Function(function)
+	{
+		m_Upvalues.reserve(function->GetUpvalues().size());
+	}
+} // namespace Glyph
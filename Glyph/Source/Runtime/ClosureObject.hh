@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Runtime/FunctionObject.hh>
+#include <Runtime/Object.hh>
+#include <Runtime/UpvalueObject.hh>
+
+#include <vector>
+
+namespace Glyph
+{
+	/// @brief A function together with the variables it captured. Functions that capture nothing are called
+	/// directly and never get a closure.
+	class ClosureObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Closure;
+
+	  public:
+		explicit ClosureObject(const FunctionObject* function);
+		~ClosureObject() = default;
+
+		[[nodiscard]] const FunctionObject* GetFunction() const { return m_Function; }
+
+		/// @brief One entry per UpvalueDescriptor of the function, in the same order.
+		[[nodiscard]] std::vector<UpvalueObject*>& GetUpvalues() { return m_Upvalues; }
+
+	  private:
+		const FunctionObject* m_Function;
+		std::vector<UpvalueObject*> m_Upvalues;
+	};
+} // namespace Glyph
@@ -4,17 +4,13 @@ namespace Glyph
 {
 	ConstantTableIndex ConstantTable::AddValue(Glyph::Value value)
 	{
-		for(size_t i = 0; i < m_Values.size(); i++)
+		auto [it, inserted] = m_Index.try_emplace(Key(value), m_Values.size());
+		if(inserted)
 		{
-			if(m_Values[i] == value)
-			{
-				return i;
-			}
+			m_Values.push_back(std::move(value));
 		}
 
-		m_Values.push_back(std::move(value));
-
-		return m_Values.size() - 1;
+		return it->second;
 	}
 
 	absl::StatusOr<const Value*> ConstantTable::GetValue(ConstantTableIndex index) const
@@ -2,7 +2,9 @@
 
 #include <Runtime/Value.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/status/statusor.h>
+#include <utility>
 #include <vector>
 
 namespace Glyph
@@ -15,12 +17,41 @@ namespace Glyph
 		ConstantTable() = default;
 		~ConstantTable() = default;
 
+		ConstantTable(ConstantTable&&) = default;
+		ConstantTable& operator=(ConstantTable&&) = default;
+
+		/// @brief Adds a value, reusing the index of an identical constant if there is one.
 		ConstantTableIndex AddValue(Value value);
 		[[nodiscard]] absl::StatusOr<const Value*> GetValue(ConstantTableIndex index) const;
+		/// @brief No bounds check, only for indices proven in range (see Bytecode::BytecodeVerifier).
+		[[nodiscard]] const Value& GetValueUnchecked(ConstantTableIndex index) const { return m_Values[index]; }
 		[[nodiscard]] size_t GetSize() const { return m_Values.size(); }
 
+	  private:
+		// Deduplication is keyed on identity, not operator==: -0.0 must not reuse the slot of 0.0, and a NaN
+		// (which never compares equal) should still find itself.
+		struct Key
+		{
+			enum Value::Type Type;
+			uint64_t Bits;
+
+			explicit Key(const Value& value)
+				: Type(value.Type())
+				, Bits(value.GetBits())
+			{
+			}
+
+			bool operator==(const Key& other) const { return Type == other.Type && Bits == other.Bits; }
+
+			template<typename H> friend H AbslHashValue(H h, const Key& key)
+			{
+				return H::combine(std::move(h), key.Type, key.Bits);
+			}
+		};
+
 	  private:
 		std::vector<Value> m_Values;
+		absl::flat_hash_map<Key, ConstantTableIndex> m_Index;
 	};
 
 } // namespace Glyph
@@ -0,0 +1,52 @@
+#include <Runtime/DictObject.hh>
+
+#include <absl/hash/hash.h>
+
+#include <cmath>
+#include <limits>
+
+namespace Glyph
+{
+	std::size_t DictObject::KeyHash::operator()(const Value& key) const
+	{
+		return absl::Hash<uint64_t> {}(key.GetBits());
+	}
+
+	DictObject::DictObject(std::size_t capacity)
+		: Object(ObjectType::Dict)
+	{
+		m_Entries.reserve(capacity);
+	}
+
+	Value DictObject::NormalizeKey(const Value& key)
+	{
+		if(!key.IsNumber())
+		{
+			return key;
+		}
+
+		auto number = key.AsNumber();
+		if(number == 0)
+		{
+			return Value(0.0);
+		}
+
+		if(std::isnan(number))
+		{
+			return Value(std::numeric_limits<double>::quiet_NaN());
+		}
+
+		return key;
+	}
+
+	const Value* DictObject::Get(const Value& key) const
+	{
+		auto it = m_Entries.find(NormalizeKey(key));
+
+		return it != m_Entries.end() ? &it->second : nullptr;
+	}
+
+	void DictObject::Set(const Value& key, const Value& value) { m_Entries.insert_or_assign(NormalizeKey(key), value); }
+
+	bool DictObject::Contains(const Value& key) const { return m_Entries.contains(NormalizeKey(key)); }
+} // namespace Glyph
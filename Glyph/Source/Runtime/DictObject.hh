@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+#include <Runtime/Value.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstddef>
+
+namespace Glyph
+{
+	/// @brief Hash table from values to values. Keys are compared by identity: numbers by their bits once -0 and
+	/// NaN are normalized, strings by pointer since they are interned, other objects by address. Ropes have to be
+	/// flattened before they are used as a key.
+	class DictObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Dict;
+
+	  private:
+		// Type and bits are all a key needs, a lookup is one probe of the table without calling back into the VM.
+		struct KeyHash
+		{
+			std::size_t operator()(const Value& key) const;
+		};
+
+		struct KeyEqual
+		{
+			bool operator()(const Value& lhs, const Value& rhs) const
+			{
+				return lhs.Type() == rhs.Type() && lhs.GetBits() == rhs.GetBits();
+			}
+		};
+
+	  public:
+		using Map = absl::flat_hash_map<Value, Value, KeyHash, KeyEqual>;
+
+	  public:
+		explicit DictObject(std::size_t capacity = 0);
+		~DictObject() = default;
+
+		/// @brief The value stored for key, nullptr when there is none.
+		[[nodiscard]] const Value* Get(const Value& key) const;
+		void Set(const Value& key, const Value& value);
+		[[nodiscard]] bool Contains(const Value& key) const;
+
+		[[nodiscard]] std::size_t GetSize() const { return m_Entries.size(); }
+		[[nodiscard]] const Map& GetEntries() const { return m_Entries; }
+
+	  private:
+		/// @brief -0 is stored as 0 and every NaN as the same NaN, so each finds itself like any other number.
+		static Value NormalizeKey(const Value& key);
+
+	  private:
+		Map m_Entries;
+	};
+} // namespace Glyph
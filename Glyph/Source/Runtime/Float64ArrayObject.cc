@@ -0,0 +1,13 @@
+#include <Runtime/Float64ArrayObject.hh>
+
+#include <algorithm>
+
+namespace Glyph
+{
+	Float64ArrayObject::Float64ArrayObject(uint32_t length)
+		: Object(ObjectType::Float64Array)
+		, m_Length(length)
+	{
+		std::fill_n(GetData(), length, 0.0);
+	}
+} // namespace Glyph
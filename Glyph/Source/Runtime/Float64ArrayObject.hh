@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Glyph
+{
+	/// @brief Fixed length array of unboxed doubles. The elements follow the object in the same allocation, so bulk
+	/// arithmetic runs over contiguous memory instead of one Value at a time, see VectorKernels.
+	class Float64ArrayObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Float64Array;
+		/// @brief Keeps the allocation size within the 32 bits an object records.
+		static constexpr std::size_t MaxLength = std::size_t(1) << 28;
+
+	  public:
+		/// @brief Bytes an array of length elements takes.
+		static constexpr std::size_t AllocationSize(std::size_t length)
+		{
+			return sizeof(Float64ArrayObject) + length * sizeof(double);
+		}
+
+		/// @brief Constructs into memory of at least AllocationSize(length) bytes, every element zero.
+		explicit Float64ArrayObject(uint32_t length);
+		~Float64ArrayObject() = default;
+
+		[[nodiscard]] double* GetData() { return reinterpret_cast<double*>(this + 1); }
+		[[nodiscard]] const double* GetData() const { return reinterpret_cast<const double*>(this + 1); }
+		[[nodiscard]] std::span<double> GetElements() { return {GetData(), m_Length}; }
+		[[nodiscard]] std::span<const double> GetElements() const { return {GetData(), m_Length}; }
+		[[nodiscard]] uint32_t GetLength() const { return m_Length; }
+
+	  private:
+		uint32_t m_Length;
+	};
+
+	static_assert(sizeof(Float64ArrayObject) % alignof(double) == 0);
+} // namespace Glyph
@@ -0,0 +1,15 @@
+#include <Runtime/FunctionObject.hh>
+
+namespace Glyph
+{
+	FunctionObject::FunctionObject(std::string name, uint32_t arity, Bytecode::BytecodeChunk chunk,
+								   std::vector<UpvalueDescriptor> upvalues, uint32_t callerLocalCount)
+		: Object(ObjectType::Function, true)
+		, m_Name(std::move(name))
+		, m_Arity(arity)
+		, m_Chunk(std::move(chunk))
+		, m_Upvalues(std::move(upvalues))
+		, m_CallerLocalCount(callerLocalCount)
+	{
+	}
+} // namespace Glyph
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Bytecode/BytecodeChunk.hh>
+#include <Runtime/Object.hh>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Glyph
+{
+	/// @brief Where a closure finds a captured variable when it is created: a local slot of the frame creating it,
+	/// or one of the upvalues of the closure running that frame.
+	struct UpvalueDescriptor
+	{
+		bool IsLocal;
+		uint32_t Index;
+
+		bool operator==(const UpvalueDescriptor&) const = default;
+	};
+
+	/// @brief A compiled function, owning the chunk with its body.
+	class FunctionObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Function;
+
+	  public:
+		FunctionObject(std::string name, uint32_t arity, Bytecode::BytecodeChunk chunk,
+					   std::vector<UpvalueDescriptor> upvalues = {}, uint32_t callerLocalCount = 0);
+		~FunctionObject() = default;
+
+		[[nodiscard]] const std::string& GetName() const { return m_Name; }
+		[[nodiscard]] uint32_t GetArity() const { return m_Arity; }
+		[[nodiscard]] const Bytecode::BytecodeChunk& GetChunk() const { return m_Chunk; }
+		[[nodiscard]] Bytecode::BytecodeChunk& GetChunk() { return m_Chunk; }
+		/// @brief Variables the function captures, a function with any has to be wrapped by a closure to run.
+		[[nodiscard]] const std::vector<UpvalueDescriptor>& GetUpvalues() const { return m_Upvalues; }
+		/// @brief Number of its caller's local slots the function reads and writes in place, non-zero only for local
+		/// functions that never escape the frame defining them. Those are only called with CALL from that frame.
+		[[nodiscard]] uint32_t GetCallerLocalCount() const { return m_CallerLocalCount; }
+
+	  private:
+		std::string m_Name;
+		uint32_t m_Arity;
+		Bytecode::BytecodeChunk m_Chunk;
+		std::vector<UpvalueDescriptor> m_Upvalues;
+		uint32_t m_CallerLocalCount;
+	};
+} // namespace Glyph
@@ -0,0 +1,425 @@
+#include <Runtime/ClosureObject.hh>
+#include <Runtime/DictObject.hh>
+#include <Runtime/Heap.hh>
+#include <Runtime/RecordObject.hh>
+#include <Runtime/RopeObject.hh>
+#include <Runtime/UpvalueObject.hh>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	/// @brief Objects handled between two looks at the clock, reading it per object would cost more than the work.
+	constexpr std::size_t SliceCheckInterval = 256;
+
+	bool IsPast(Glyph::Heap::Deadline deadline, std::size_t work)
+	{
+		return work % SliceCheckInterval == 0 && deadline != Glyph::Heap::Deadline::max()
+			   && std::chrono::steady_clock::now() >= deadline;
+	}
+} // namespace
+
+namespace Glyph
+{
+	Heap::Heap(HeapOptions options)
+		: m_Options(options)
+		, m_Threshold(options.InitialThreshold)
+		, m_Trigger(options.InitialThreshold)
+	{
+	}
+
+	Heap::~Heap()
+	{
+		Clear();
+
+		for(auto* block : m_Blocks)
+		{
+			FreeBlock(block);
+		}
+	}
+
+	Heap::BlockHeader* Heap::BlockOf(const void* address)
+	{
+		// Blocks are aligned to their size, the header sits at the start of the block an address falls into.
+		return reinterpret_cast<BlockHeader*>(reinterpret_cast<uintptr_t>(address) & ~(BlockSize - 1));
+	}
+
+	void* Heap::AllocateRaw(std::size_t size)
+	{
+		if(size > LargeObjectSize)
+		{
+			return ::operator new(size);
+		}
+
+		while(static_cast<std::size_t>(m_Limit - m_Cursor) < size)
+		{
+			if(!NextHole())
+			{
+				m_Block = NewBlock();
+				m_NextLine = HeaderLines;
+			}
+		}
+
+		auto* memory = m_Cursor;
+		m_Cursor += size;
+
+		return memory;
+	}
+
+	void Heap::Register(Object* object, std::size_t size)
+	{
+		object->SetSize(size);
+		object->SetNext(m_Objects);
+		m_Objects = object;
+
+		// Allocated black while marking, nothing points at a new object yet that would have to be scanned first.
+		object->SetMarked(m_Phase == CollectionPhase::Marking);
+
+		m_AllocatedBytes += size;
+	}
+
+	bool Heap::NextHole()
+	{
+		while(true)
+		{
+			if(m_Block)
+			{
+				auto* marks = m_Block->LineMarks;
+
+				auto first = m_NextLine;
+				while(first < LinesPerBlock && !IsLineFree(marks[first]))
+				{
+					first++;
+				}
+
+				auto last = first;
+				while(last < LinesPerBlock && IsLineFree(marks[last]))
+				{
+					last++;
+				}
+
+				m_NextLine = last;
+
+				if(first < last)
+				{
+					// The whole hole is taken up front, objects bumped into it survive a sweep that started earlier.
+					auto epoch = m_Phase == CollectionPhase::Sweeping ? m_Epoch + 1 : m_Epoch;
+					std::fill(marks + first, marks + last, epoch);
+
+					auto* data = reinterpret_cast<std::byte*>(m_Block);
+					m_Cursor = data + first * LineSize;
+					m_Limit = data + last * LineSize;
+
+					return true;
+				}
+			}
+
+			if(m_Recyclable.empty())
+			{
+				return false;
+			}
+
+			m_Block = m_Recyclable.back();
+			m_Recyclable.pop_back();
+			m_NextLine = HeaderLines;
+		}
+	}
+
+	Heap::BlockHeader* Heap::NewBlock()
+	{
+		auto* block = static_cast<BlockHeader*>(::operator new(BlockSize, std::align_val_t(BlockSize)));
+		std::memset(block->LineMarks, 0, sizeof(block->LineMarks));
+		std::fill_n(block->LineMarks, HeaderLines, HeaderMark);
+
+		m_Blocks.push_back(block);
+
+		return block;
+	}
+
+	void Heap::FreeBlock(BlockHeader* block) { ::operator delete(block, std::align_val_t(BlockSize)); }
+
+	void Heap::ResetAllocation()
+	{
+		m_Block = nullptr;
+		m_Cursor = m_Limit = nullptr;
+	}
+
+	void Heap::Free(Object* object)
+	{
+		if(object->IsType(ObjectType::String))
+		{
+			m_Strings.Remove(static_cast<StringObject*>(object));
+		}
+
+		auto size = object->GetSize();
+		Object::Finalize(object);
+
+		if(size > LargeObjectSize)
+		{
+			::operator delete(object);
+		}
+
+		m_AllocatedBytes -= size;
+	}
+
+	void Heap::Mark(Object* object)
+	{
+		// Permanent objects belong to their chunk, the constants a function references are roots of their own.
+		if(!object || object->IsMarked() || object->IsPermanent())
+		{
+			return;
+		}
+
+		object->SetMarked(true);
+		m_Gray.push_back(object);
+	}
+
+	void Heap::Mark(const Value& value)
+	{
+		if(value.IsObject())
+		{
+			Mark(value.AsObject());
+		}
+	}
+
+	StringObject* Heap::FindString(std::string_view chars, uint64_t hash)
+	{
+		auto* string = m_Strings.Find(chars, hash);
+		if(!string)
+		{
+			return nullptr;
+		}
+
+		// A white string found while sweeping may be garbage about to be freed, marking it keeps it for this cycle.
+		// It has no children to trace, the mark is cleared by the sweep of the next cycle at the latest.
+		if(m_Phase == CollectionPhase::Marking)
+		{
+			Mark(string);
+		}
+		else if(m_Phase == CollectionPhase::Sweeping && !string->IsPermanent())
+		{
+			string->SetMarked(true);
+		}
+
+		return string;
+	}
+
+	void Heap::BeginMarking()
+	{
+		m_Phase = CollectionPhase::Marking;
+		m_Trigger = m_AllocatedBytes + m_Options.IncrementalStepBytes;
+	}
+
+	bool Heap::TraceSlice(Deadline deadline)
+	{
+		// An explicit worklist instead of recursion, long chains of objects can't overflow the native stack.
+		std::size_t work = 0;
+		while(!m_Gray.empty())
+		{
+			if(IsPast(deadline, ++work))
+			{
+				m_Trigger = m_AllocatedBytes + m_Options.IncrementalStepBytes;
+				return false;
+			}
+
+			auto* object = m_Gray.back();
+			m_Gray.pop_back();
+
+			Blacken(object);
+		}
+
+		m_Trigger = m_AllocatedBytes + m_Options.IncrementalStepBytes;
+		return true;
+	}
+
+	void Heap::Blacken(Object* object)
+	{
+		switch(object->GetType())
+		{
+			case ObjectType::Closure:
+				for(auto* upvalue : static_cast<ClosureObject*>(object)->GetUpvalues())
+				{
+					Mark(upvalue);
+				}
+				break;
+
+			case ObjectType::Upvalue: Mark(*static_cast<UpvalueObject*>(object)->GetLocation()); break;
+
+			case ObjectType::Rope:
+			{
+				auto* rope = static_cast<RopeObject*>(object);
+				Mark(rope->GetLeft());
+				Mark(rope->GetRight());
+				Mark(rope->GetFlat());
+				break;
+			}
+
+			case ObjectType::Dict:
+				for(const auto& [key, value] : static_cast<DictObject*>(object)->GetEntries())
+				{
+					Mark(key);
+					Mark(value);
+				}
+				break;
+
+			case ObjectType::Record:
+				for(const auto& field : static_cast<RecordObject*>(object)->GetFields())
+				{
+					Mark(field);
+				}
+				break;
+
+			case ObjectType::Function:
+			case ObjectType::String:
+			case ObjectType::Float64Array:
+			case ObjectType::Native: break;
+		}
+	}
+
+	void Heap::MarkLines(const Object* object, uint8_t epoch)
+	{
+		auto* block = BlockOf(object);
+		auto offset = reinterpret_cast<const std::byte*>(object) - reinterpret_cast<const std::byte*>(block);
+
+		auto first = offset / LineSize;
+		auto last = (offset + object->GetSize() - 1) / LineSize;
+		std::fill(block->LineMarks + first, block->LineMarks + last + 1, epoch);
+	}
+
+	void Heap::BeginSweep()
+	{
+		m_Phase = CollectionPhase::Sweeping;
+
+		m_Unswept = m_Objects;
+		m_Objects = nullptr;
+
+		// Holes taken so far are marked with the old epoch, objects bumped into them from now on would look free
+		// once the sweep ends.
+		ResetAllocation();
+	}
+
+	bool Heap::SweepSlice(Deadline deadline)
+	{
+		uint8_t epoch = m_Epoch + 1;
+
+		std::size_t work = 0;
+		while(m_Unswept)
+		{
+			if(IsPast(deadline, ++work))
+			{
+				m_Trigger = m_AllocatedBytes + m_Options.IncrementalStepBytes;
+				return false;
+			}
+
+			auto* object = m_Unswept;
+			m_Unswept = object->GetNext();
+
+			if(!object->IsMarked())
+			{
+				Free(object);
+				continue;
+			}
+
+			object->SetMarked(false);
+			if(object->GetSize() <= LargeObjectSize)
+			{
+				MarkLines(object, epoch);
+			}
+
+			object->SetNext(m_Survivors);
+			m_Survivors = object;
+			if(!m_LastSurvivor)
+			{
+				m_LastSurvivor = object;
+			}
+		}
+
+		FinishSweep();
+		return true;
+	}
+
+	void Heap::FinishSweep()
+	{
+		if(m_LastSurvivor)
+		{
+			m_LastSurvivor->SetNext(m_Objects);
+			m_Objects = m_Survivors;
+			m_Survivors = m_LastSurvivor = nullptr;
+		}
+
+		// Once the epochs run out every mark is folded back to 1 for live lines and 0 for the rest.
+		uint8_t live = m_Epoch + 1;
+		bool fold = live > MaxEpoch;
+
+		// Every block with a free line is bumped through again, surplus empty ones go back to the system.
+		m_Recyclable.clear();
+		std::size_t emptyBlocks = 0;
+		std::erase_if(m_Blocks,
+					  [&](BlockHeader* block)
+					  {
+						  auto* begin = block->LineMarks + HeaderLines;
+						  auto* end = block->LineMarks + LinesPerBlock;
+
+						  if(fold)
+						  {
+							  std::transform(begin, end, begin, [&](uint8_t mark) { return mark == live ? 1 : 0; });
+						  }
+
+						  if(block == m_Block)
+						  {
+							  return false;
+						  }
+
+						  auto mark = fold ? 1 : live;
+						  if(std::find(begin, end, mark) == end && ++emptyBlocks > m_Options.RetainedEmptyBlocks)
+						  {
+							  FreeBlock(block);
+							  return true;
+						  }
+
+						  if(std::find_if(begin, end, [&](uint8_t line) { return line != mark; }) != end)
+						  {
+							  m_Recyclable.push_back(block);
+						  }
+
+						  return false;
+					  });
+
+		m_Epoch = fold ? 1 : live;
+		m_Phase = CollectionPhase::Idle;
+
+		m_Threshold = std::max(m_Options.InitialThreshold,
+							   static_cast<std::size_t>(static_cast<double>(m_AllocatedBytes) * m_Options.GrowthFactor));
+		m_Trigger = m_Threshold;
+		m_CollectionCount++;
+	}
+
+	void Heap::Clear()
+	{
+		m_Strings.Clear();
+
+		for(auto* list : {&m_Objects, &m_Unswept, &m_Survivors})
+		{
+			while(*list)
+			{
+				auto* next = (*list)->GetNext();
+				Free(*list);
+				*list = next;
+			}
+		}
+
+		m_LastSurvivor = nullptr;
+		m_Gray.clear();
+		m_Phase = CollectionPhase::Idle;
+		m_Trigger = m_Threshold;
+
+		for(auto* block : m_Blocks)
+		{
+			std::fill(block->LineMarks + HeaderLines, block->LineMarks + LinesPerBlock, 0);
+		}
+
+		m_Recyclable = m_Blocks;
+		ResetAllocation();
+	}
+} // namespace Glyph
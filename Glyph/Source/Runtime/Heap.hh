@@ -0,0 +1,205 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+#include <Runtime/StringObject.hh>
+#include <Runtime/StringTable.hh>
+#include <Runtime/Value.hh>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Glyph
+{
+	struct HeapOptions
+	{
+		/// @brief Bytes allocated before the first collection runs.
+		std::size_t InitialThreshold = 1024 * 1024;
+		/// @brief The next collection runs once the heap reaches this multiple of what survived the last one.
+		double GrowthFactor = 2.0;
+		/// @brief Empty blocks kept after a collection instead of being returned to the system.
+		std::size_t RetainedEmptyBlocks = 4;
+
+		/// @brief Spread marking and sweeping over many short slices instead of stopping the world for a whole cycle.
+		bool Incremental = false;
+		/// @brief Bytes allocated between two slices of an incremental cycle.
+		std::size_t IncrementalStepBytes = 256 * 1024;
+		/// @brief Time a single slice may take, checked every few hundred objects.
+		std::chrono::microseconds SliceBudget {500};
+	};
+
+	enum class CollectionPhase
+	{
+		Idle,
+		Marking,
+		Sweeping
+	};
+
+	/// @brief Garbage collected object space. Small objects are bump allocated into fixed size blocks, split into
+	/// lines; a collection marks the lines live objects touch and allocation later bumps through the free ones in
+	/// between. Objects never move, so Values and raw pointers to them stay valid across collections.
+	/// The heap does not know the roots, the owner marks them and drives the phases of a cycle.
+	///
+	/// Marking is tri-color: marked objects on the gray stack still have to be scanned, marked ones off it are black.
+	/// A cycle can run in slices while the program keeps going. Objects allocated while marking start out black and
+	/// stores of references into heap objects go through WriteBarrier, which keeps a black object from pointing at a
+	/// white one. Roots are rescanned before marking ends.
+	class Heap
+	{
+	  public:
+		static constexpr std::size_t BlockSize = 32 * 1024;
+		static constexpr std::size_t LineSize = 128;
+		static constexpr std::size_t LinesPerBlock = BlockSize / LineSize;
+		/// @brief Objects above this size get their own allocation instead of a place in a block.
+		static constexpr std::size_t LargeObjectSize = 8 * 1024;
+		static constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+		using Deadline = std::chrono::steady_clock::time_point;
+
+	  public:
+		explicit Heap(HeapOptions options = {});
+		~Heap();
+
+		Heap(const Heap&) = delete;
+		Heap& operator=(const Heap&) = delete;
+
+		template<typename TObject, typename... TArgs> TObject* Allocate(TArgs&&... args)
+		{
+			return AllocateSized<TObject>(sizeof(TObject), std::forward<TArgs>(args)...);
+		}
+
+		/// @brief Allocates size bytes for an object followed by data of its own, like the characters of a string.
+		template<typename TObject, typename... TArgs> TObject* AllocateSized(std::size_t size, TArgs&&... args)
+		{
+			static_assert(std::is_base_of_v<Object, TObject>);
+			size = AlignSize(size);
+
+			auto* object = new(AllocateRaw(size)) TObject(std::forward<TArgs>(args)...);
+			Register(object, size);
+
+			return object;
+		}
+
+		/// @brief The interned string with these characters, nullptr when there is none. A string found while a cycle
+		/// is in progress is kept alive by it, the caller is about to hold on to it.
+		StringObject* FindString(std::string_view chars, uint64_t hash);
+		/// @brief Interns a string, FindString returns it for its characters until it is freed.
+		void AddString(StringObject* string) { m_Strings.Add(string); }
+
+		/// @brief Whether the owner should start a cycle, or run the next slice of the one in progress.
+		[[nodiscard]] bool ShouldCollect() const { return m_AllocatedBytes >= m_Trigger; }
+
+		/// @brief Keeps a black owner from pointing at a white object, call after storing value into owner.
+		void WriteBarrier(const Object* owner, const Value& value)
+		{
+			if(m_Phase == CollectionPhase::Marking && owner->IsMarked()) [[unlikely]]
+			{
+				Mark(value);
+			}
+		}
+
+		void WriteBarrier(const Object* owner, Object* value)
+		{
+			if(m_Phase == CollectionPhase::Marking && owner->IsMarked()) [[unlikely]]
+			{
+				Mark(value);
+			}
+		}
+
+		/// @brief Marks an object gray, its children are marked when it is traced.
+		void Mark(Object* object);
+		void Mark(const Value& value);
+
+		/// @brief Starts a cycle, the owner marks the roots right after.
+		void BeginMarking();
+
+		/// @brief Scans gray objects until none are left or the deadline passed.
+		/// @return Whether the gray stack is empty.
+		bool TraceSlice(Deadline deadline);
+		void Trace() { TraceSlice(Deadline::max()); }
+
+		/// @brief Ends marking, every object still white is garbage.
+		void BeginSweep();
+
+		/// @brief Frees unmarked objects until all are swept or the deadline passed, then finishes the cycle.
+		/// @return Whether the cycle is finished.
+		bool SweepSlice(Deadline deadline);
+		void Sweep() { SweepSlice(Deadline::max()); }
+
+		/// @brief Frees every object regardless of marks and abandons a cycle in progress. Interned strings owned
+		/// elsewhere are forgotten too.
+		void Clear();
+
+		[[nodiscard]] const HeapOptions& GetOptions() const { return m_Options; }
+		[[nodiscard]] CollectionPhase GetPhase() const { return m_Phase; }
+		[[nodiscard]] std::size_t GetAllocatedBytes() const { return m_AllocatedBytes; }
+		[[nodiscard]] std::size_t GetThreshold() const { return m_Threshold; }
+		[[nodiscard]] std::size_t GetBlockCount() const { return m_Blocks.size(); }
+		[[nodiscard]] std::size_t GetCollectionCount() const { return m_CollectionCount; }
+
+	  private:
+		// The first lines of a block hold its line marks and are never handed out. A mark is the epoch of the last
+		// cycle a live object touched the line in, so lines don't need clearing between cycles.
+		struct BlockHeader
+		{
+			uint8_t LineMarks[LinesPerBlock];
+		};
+
+		static constexpr std::size_t HeaderLines = (sizeof(BlockHeader) + LineSize - 1) / LineSize;
+		static constexpr uint8_t HeaderMark = 0xFF;
+		static constexpr uint8_t MaxEpoch = HeaderMark - 2;
+
+		static constexpr std::size_t AlignSize(std::size_t size) { return (size + Alignment - 1) & ~(Alignment - 1); }
+
+		static BlockHeader* BlockOf(const void* address);
+
+		void* AllocateRaw(std::size_t size);
+		void Register(Object* object, std::size_t size);
+
+		/// @brief A line is taken when marked in this epoch, or in the next one by a sweep in progress.
+		[[nodiscard]] bool IsLineFree(uint8_t mark) const { return mark != m_Epoch && mark != m_Epoch + 1; }
+
+		/// @brief Moves the bump range to the next run of free lines, in the current block or a recycled one.
+		bool NextHole();
+		BlockHeader* NewBlock();
+		void FreeBlock(BlockHeader* block);
+		void ResetAllocation();
+		void Free(Object* object);
+
+		void MarkLines(const Object* object, uint8_t epoch);
+		void Blacken(Object* object);
+		void FinishSweep();
+
+	  private:
+		HeapOptions m_Options;
+		CollectionPhase m_Phase {CollectionPhase::Idle};
+
+		Object* m_Objects {nullptr};
+		std::vector<Object*> m_Gray;
+		/// @brief Weak, a string is removed when it is freed.
+		StringTable m_Strings;
+
+		// While sweeping the objects of the cycle are split off, new ones go to m_Objects.
+		Object* m_Unswept {nullptr};
+		Object* m_Survivors {nullptr};
+		Object* m_LastSurvivor {nullptr};
+
+		std::vector<BlockHeader*> m_Blocks;
+		/// @brief Blocks with free lines left to bump through, refilled by every sweep.
+		std::vector<BlockHeader*> m_Recyclable;
+		BlockHeader* m_Block {nullptr};
+		std::size_t m_NextLine {0};
+		std::byte* m_Cursor {nullptr};
+		std::byte* m_Limit {nullptr};
+		uint8_t m_Epoch {1};
+
+		std::size_t m_AllocatedBytes {0};
+		std::size_t m_Threshold;
+		std::size_t m_Trigger;
+		std::size_t m_CollectionCount {0};
+	};
+} // namespace Glyph
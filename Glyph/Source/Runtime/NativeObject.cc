@@ -0,0 +1,14 @@
+#include <Runtime/NativeObject.hh>
+
+#include <utility>
+
+namespace Glyph
+{
+	NativeObject::NativeObject(std::string name, uint32_t arity, NativeFunction function)
+		: Object(ObjectType::Native, true)
+		, m_Name(std::move(name))
+		, m_Arity(arity)
+		, m_Function(function)
+	{
+	}
+} // namespace Glyph
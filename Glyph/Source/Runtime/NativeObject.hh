@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+#include <Runtime/Value.hh>
+
+#include <absl/status/statusor.h>
+
+#include <cstdint>
+#include <string>
+
+namespace Glyph::Bytecode
+{
+	class VM;
+} // namespace Glyph::Bytecode
+
+namespace Glyph
+{
+	/// @brief A built-in implemented in C++. args points at the arguments on the value stack, they stay rooted while
+	/// the native runs and may allocate.
+	using NativeFunction = absl::StatusOr<Value> (*)(Bytecode::VM& vm, const Value* args);
+
+	/// @brief A built-in function, callable like any compiled one. Natives are owned by the VM, not the heap.
+	class NativeObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Native;
+
+	  public:
+		NativeObject(std::string name, uint32_t arity, NativeFunction function);
+		~NativeObject() = default;
+
+		[[nodiscard]] const std::string& GetName() const { return m_Name; }
+		[[nodiscard]] uint32_t GetArity() const { return m_Arity; }
+		[[nodiscard]] NativeFunction GetFunction() const { return m_Function; }
+
+	  private:
+		std::string m_Name;
+		uint32_t m_Arity;
+		NativeFunction m_Function;
+	};
+} // namespace Glyph
@@ -0,0 +1,53 @@
+#include <Runtime/ClosureObject.hh>
+#include <Runtime/DictObject.hh>
+#include <Runtime/Float64ArrayObject.hh>
+#include <Runtime/FunctionObject.hh>
+#include <Runtime/NativeObject.hh>
+#include <Runtime/Object.hh>
+#include <Runtime/RecordObject.hh>
+#include <Runtime/RopeObject.hh>
+#include <Runtime/StringObject.hh>
+#include <Runtime/UpvalueObject.hh>
+
+namespace Glyph
+{
+	Object::Object(ObjectType type, bool permanent)
+		: m_Type(type)
+		, m_Permanent(permanent)
+	{
+	}
+
+	std::string Object::ToString() const
+	{
+		switch(m_Type)
+		{
+			case ObjectType::Function: return "<fn " + static_cast<const FunctionObject*>(this)->GetName() + ">";
+			case ObjectType::Closure:
+				return "<fn " + static_cast<const ClosureObject*>(this)->GetFunction()->GetName() + ">";
+			case ObjectType::Upvalue: return "<upvalue>";
+			case ObjectType::String: return std::string(static_cast<const StringObject*>(this)->GetView());
+			case ObjectType::Rope: return static_cast<const RopeObject*>(this)->Join();
+			case ObjectType::Dict: return "<dict>";
+			case ObjectType::Float64Array: return "<array>";
+			case ObjectType::Native: return "<native fn " + static_cast<const NativeObject*>(this)->GetName() + ">";
+			case ObjectType::Record: return "<record>";
+			default: return "<object>";
+		}
+	}
+
+	void Object::Finalize(Object* object)
+	{
+		switch(object->m_Type)
+		{
+			case ObjectType::Function: static_cast<FunctionObject*>(object)->~FunctionObject(); break;
+			case ObjectType::Closure: static_cast<ClosureObject*>(object)->~ClosureObject(); break;
+			case ObjectType::Upvalue: static_cast<UpvalueObject*>(object)->~UpvalueObject(); break;
+			case ObjectType::String: static_cast<StringObject*>(object)->~StringObject(); break;
+			case ObjectType::Rope: static_cast<RopeObject*>(object)->~RopeObject(); break;
+			case ObjectType::Dict: static_cast<DictObject*>(object)->~DictObject(); break;
+			case ObjectType::Float64Array: static_cast<Float64ArrayObject*>(object)->~Float64ArrayObject(); break;
+			case ObjectType::Native: static_cast<NativeObject*>(object)->~NativeObject(); break;
+			case ObjectType::Record: static_cast<RecordObject*>(object)->~RecordObject(); break;
+		}
+	}
+} // namespace Glyph
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Glyph
+{
+	enum class ObjectType : uint8_t
+	{
+		Function,
+		Closure,
+		Upvalue,
+		String,
+		Rope,
+		Dict,
+		Float64Array,
+		Native,
+		Record
+	};
+
+	/// @brief Header shared by everything a Value can point to. Everything but permanent objects, functions and
+	/// string literals owned by the chunk declaring them, lives on the Heap and is freed by its collector.
+	class Object
+	{
+	  public:
+		Object(const Object&) = delete;
+		Object& operator=(const Object&) = delete;
+
+		[[nodiscard]] ObjectType GetType() const { return m_Type; }
+		[[nodiscard]] bool IsType(ObjectType type) const { return m_Type == type; }
+
+		template<typename TObject> [[nodiscard]] TObject* As()
+		{
+			return IsType(TObject::Type) ? static_cast<TObject*>(this) : nullptr;
+		}
+
+		[[nodiscard]] std::string ToString() const;
+
+		/// @brief Intrusive list of every object on the heap, walked by the sweep.
+		[[nodiscard]] Object* GetNext() const { return m_Next; }
+		void SetNext(Object* next) { m_Next = next; }
+
+		/// @brief Owned outside the heap, the collector neither marks nor frees it.
+		[[nodiscard]] bool IsPermanent() const { return m_Permanent; }
+
+		[[nodiscard]] bool IsMarked() const { return m_Marked; }
+		void SetMarked(bool marked) { m_Marked = marked; }
+
+		/// @brief Bytes the heap reserved for the object, header included.
+		[[nodiscard]] uint32_t GetSize() const { return m_Size; }
+		void SetSize(uint32_t size) { m_Size = size; }
+
+		/// @brief Runs the destructor of the concrete type, the destructor is not virtual. The memory is left to
+		/// whoever allocated it.
+		static void Finalize(Object* object);
+
+	  protected:
+		explicit Object(ObjectType type, bool permanent = false);
+		~Object() = default;
+
+	  private:
+		ObjectType m_Type;
+		bool m_Marked {false};
+		bool m_Permanent;
+		uint32_t m_Size {0};
+		Object* m_Next {nullptr};
+	};
+} // namespace Glyph
@@ -0,0 +1,45 @@
+#include <Runtime/PauseHistogram.hh>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Glyph
+{
+	void PauseHistogram::Record(std::chrono::nanoseconds pause)
+	{
+		auto micros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(pause).count());
+		auto bucket = std::min<std::size_t>(std::bit_width(micros), BucketCount - 1);
+
+		m_Buckets[bucket]++;
+		m_Count++;
+		m_Total += pause;
+		m_Max = std::max(m_Max, pause);
+	}
+
+	std::chrono::microseconds PauseHistogram::GetBucketLimit(std::size_t bucket)
+	{
+		return std::chrono::microseconds(uint64_t(1) << bucket);
+	}
+
+	std::chrono::microseconds PauseHistogram::GetPercentile(double fraction) const
+	{
+		if(m_Count == 0)
+		{
+			return std::chrono::microseconds(0);
+		}
+
+		auto rank = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * m_Count));
+		uint64_t seen = 0;
+		for(std::size_t bucket = 0; bucket < BucketCount; bucket++)
+		{
+			seen += m_Buckets[bucket];
+			if(seen >= std::max<uint64_t>(rank, 1))
+			{
+				return GetBucketLimit(bucket);
+			}
+		}
+
+		return GetBucketLimit(BucketCount - 1);
+	}
+} // namespace Glyph
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Glyph
+{
+	/// @brief Distribution of garbage collector pauses in power of two buckets, bucket 0 counts pauses under 1us and
+	/// bucket i those under 2^i us. The last bucket takes everything longer.
+	class PauseHistogram
+	{
+	  public:
+		static constexpr std::size_t BucketCount = 24;
+
+	  public:
+		void Record(std::chrono::nanoseconds pause);
+
+		/// @brief Exclusive upper bound of a bucket.
+		[[nodiscard]] static std::chrono::microseconds GetBucketLimit(std::size_t bucket);
+
+		[[nodiscard]] uint64_t GetBucket(std::size_t bucket) const { return m_Buckets[bucket]; }
+		[[nodiscard]] uint64_t GetCount() const { return m_Count; }
+		[[nodiscard]] std::chrono::nanoseconds GetTotal() const { return m_Total; }
+		[[nodiscard]] std::chrono::nanoseconds GetMax() const { return m_Max; }
+
+		/// @brief Upper bound of the bucket holding the given fraction (0 to 1) of the pauses, zero without any.
+		[[nodiscard]] std::chrono::microseconds GetPercentile(double fraction) const;
+
+	  private:
+		std::array<uint64_t, BucketCount> m_Buckets {};
+		uint64_t m_Count {0};
+		std::chrono::nanoseconds m_Total {0};
+		std::chrono::nanoseconds m_Max {0};
+	};
+} // namespace Glyph
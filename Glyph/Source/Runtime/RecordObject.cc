@@ -0,0 +1,13 @@
+#include <Runtime/RecordObject.hh>
+
+#include <memory>
+
+namespace Glyph
+{
+	RecordObject::RecordObject(const Shape* shape)
+		: Object(ObjectType::Record)
+		, m_Shape(shape)
+	{
+		std::uninitialized_default_construct_n(GetSlots(), shape->GetFieldCount());
+	}
+} // namespace Glyph
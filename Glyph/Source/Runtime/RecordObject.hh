@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+#include <Runtime/Shape.hh>
+#include <Runtime/Value.hh>
+
+#include <cstddef>
+#include <span>
+
+namespace Glyph
+{
+	/// @brief Fixed set of named fields. The shape maps names to slots, the slots follow the object in the same
+	/// allocation, so a field access that knows the shape is a single load.
+	class RecordObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Record;
+
+	  public:
+		/// @brief Bytes a record of this many fields takes.
+		static constexpr std::size_t AllocationSize(std::size_t fieldCount)
+		{
+			return sizeof(RecordObject) + fieldCount * sizeof(Value);
+		}
+
+		/// @brief Constructs into memory of at least AllocationSize(shape->GetFieldCount()) bytes, every field null.
+		explicit RecordObject(const Shape* shape);
+		~RecordObject() = default;
+
+		[[nodiscard]] const Shape* GetShape() const { return m_Shape; }
+
+		[[nodiscard]] Value* GetSlots() { return reinterpret_cast<Value*>(this + 1); }
+		[[nodiscard]] std::span<Value> GetFields() { return {GetSlots(), m_Shape->GetFieldCount()}; }
+
+	  private:
+		const Shape* m_Shape;
+	};
+
+	static_assert(sizeof(RecordObject) % alignof(Value) == 0);
+} // namespace Glyph
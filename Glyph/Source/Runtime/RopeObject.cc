@@ -0,0 +1,62 @@
+#include <Runtime/RopeObject.hh>
+
+#include <vector>
+
+namespace Glyph
+{
+	RopeObject::RopeObject(Object* left, Object* right, uint32_t length)
+		: Object(ObjectType::Rope)
+		, m_Left(left)
+		, m_Right(right)
+		, m_Length(length)
+	{
+	}
+
+	uint32_t RopeObject::LengthOf(const Object* text)
+	{
+		return text->IsType(ObjectType::String) ? static_cast<const StringObject*>(text)->GetLength()
+												: static_cast<const RopeObject*>(text)->GetLength();
+	}
+
+	void RopeObject::AppendTo(std::string& out, const Object* text)
+	{
+		// Appending builds ropes leaning to the left, as deep as the number of pieces: walk them with a worklist.
+		std::vector<const Object*> pending {text};
+		while(!pending.empty())
+		{
+			const auto* object = pending.back();
+			pending.pop_back();
+
+			if(object->IsType(ObjectType::String))
+			{
+				out += static_cast<const StringObject*>(object)->GetView();
+				continue;
+			}
+
+			const auto* rope = static_cast<const RopeObject*>(object);
+			if(rope->m_Flat)
+			{
+				out += rope->m_Flat->GetView();
+				continue;
+			}
+
+			pending.push_back(rope->m_Right);
+			pending.push_back(rope->m_Left);
+		}
+	}
+
+	void RopeObject::SetFlat(StringObject* flat)
+	{
+		m_Flat = flat;
+		m_Left = m_Right = nullptr;
+	}
+
+	std::string RopeObject::Join() const
+	{
+		std::string out;
+		out.reserve(m_Length);
+		AppendTo(out, this);
+
+		return out;
+	}
+} // namespace Glyph
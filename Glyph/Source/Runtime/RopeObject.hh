@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+#include <Runtime/StringObject.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Glyph
+{
+	/// @brief Lazy concatenation of two strings or ropes. Appending to a long string links the two instead of copying
+	/// them, so building a string piece by piece stays linear. The characters are joined and interned the first time
+	/// the rope is compared, the result is kept and the pieces are dropped.
+	class RopeObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Rope;
+		/// @brief Concatenations shorter than this are copied right away, short strings are cheaper flat.
+		static constexpr std::size_t MinLength = 64;
+
+	  public:
+		RopeObject(Object* left, Object* right, uint32_t length);
+		~RopeObject() = default;
+
+		/// @brief Length of a string or rope.
+		[[nodiscard]] static uint32_t LengthOf(const Object* text);
+		/// @brief Appends the characters of a string or rope, without allocating on the heap.
+		static void AppendTo(std::string& out, const Object* text);
+
+		[[nodiscard]] Object* GetLeft() const { return m_Left; }
+		[[nodiscard]] Object* GetRight() const { return m_Right; }
+		[[nodiscard]] uint32_t GetLength() const { return m_Length; }
+
+		/// @brief The interned string once the rope has been flattened, nullptr before.
+		[[nodiscard]] StringObject* GetFlat() const { return m_Flat; }
+		void SetFlat(StringObject* flat);
+
+		[[nodiscard]] std::string Join() const;
+
+	  private:
+		Object* m_Left;
+		Object* m_Right;
+		StringObject* m_Flat {nullptr};
+		uint32_t m_Length;
+	};
+} // namespace Glyph
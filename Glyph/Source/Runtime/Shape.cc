@@ -0,0 +1,40 @@
+#include <Runtime/Shape.hh>
+
+#include <utility>
+
+namespace Glyph
+{
+	Shape::Shape() = default;
+	Shape::~Shape() = default;
+
+	Shape::Shape(const Shape* parent, std::string name)
+		: m_Parent(parent)
+		, m_Name(std::move(name))
+		, m_FieldCount(parent->m_FieldCount + 1)
+	{
+	}
+
+	std::optional<uint32_t> Shape::Find(std::string_view name) const
+	{
+		for(const auto* shape = this; shape->m_Parent; shape = shape->m_Parent)
+		{
+			if(shape->m_Name == name)
+			{
+				return shape->m_FieldCount - 1;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	Shape* Shape::AddField(std::string_view name)
+	{
+		auto& child = m_Transitions[std::string(name)];
+		if(!child)
+		{
+			child.reset(new Shape(this, std::string(name)));
+		}
+
+		return child.get();
+	}
+} // namespace Glyph
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Glyph
+{
+	/// @brief Hidden class of a record: its field names in order, field i lives in slot i. Shapes form a tree rooted
+	/// at the empty one, adding a field moves to a child, so records built with the same field sequence share one
+	/// shape and a slot found for a shape holds for every record of it.
+	///
+	/// The tree is owned by the VM and only grows, a shape stays valid as long as its VM.
+	class Shape
+	{
+	  public:
+		/// @brief The empty shape at the root.
+		Shape();
+		~Shape();
+
+		Shape(const Shape&) = delete;
+		Shape& operator=(const Shape&) = delete;
+
+		[[nodiscard]] const Shape* GetParent() const { return m_Parent; }
+		/// @brief Name of the last field, the one this shape added to its parent. Empty at the root.
+		[[nodiscard]] const std::string& GetName() const { return m_Name; }
+		[[nodiscard]] uint32_t GetFieldCount() const { return m_FieldCount; }
+
+		/// @brief The slot of the field, walking up to the root. Runs on an inline cache miss only.
+		[[nodiscard]] std::optional<uint32_t> Find(std::string_view name) const;
+
+		/// @brief This shape followed by name, created the first time it is asked for.
+		Shape* AddField(std::string_view name);
+
+	  private:
+		Shape(const Shape* parent, std::string name);
+
+	  private:
+		const Shape* m_Parent {nullptr};
+		std::string m_Name;
+		uint32_t m_FieldCount {0};
+		absl::flat_hash_map<std::string, std::unique_ptr<Shape>> m_Transitions;
+	};
+} // namespace Glyph
@@ -0,0 +1,34 @@
+#include <Runtime/StringObject.hh>
+
+#include <absl/hash/hash.h>
+
+#include <cstring>
+#include <new>
+
+namespace Glyph
+{
+	void StringDeleter::operator()(StringObject* string) const
+	{
+		Object::Finalize(string);
+		::operator delete(string);
+	}
+
+	uint64_t StringObject::Hash(std::string_view chars) { return absl::Hash<std::string_view> {}(chars); }
+
+	OwnedString StringObject::CreatePermanent(std::string_view chars)
+	{
+		auto* memory = ::operator new(AllocationSize(chars.size()));
+
+		return OwnedString(new(memory) StringObject(chars, Hash(chars), true));
+	}
+
+	StringObject::StringObject(std::string_view chars, uint64_t hash, bool permanent)
+		: Object(ObjectType::String, permanent)
+		, m_Hash(hash)
+		, m_Length(static_cast<uint32_t>(chars.size()))
+	{
+		auto* data = reinterpret_cast<char*>(this + 1);
+		std::memcpy(data, chars.data(), chars.size());
+		data[chars.size()] = '\0';
+	}
+} // namespace Glyph
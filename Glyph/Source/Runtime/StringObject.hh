@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+
+namespace Glyph
+{
+	class StringObject;
+
+	/// @brief Frees a permanent string, see StringObject::CreatePermanent.
+	struct StringDeleter
+	{
+		void operator()(StringObject* string) const;
+	};
+
+	using OwnedString = std::unique_ptr<StringObject, StringDeleter>;
+
+	/// @brief An immutable, interned string. The characters follow the object in the same allocation and the hash is
+	/// computed once. Two strings with the same characters are always the same object, so equality is a pointer
+	/// comparison: literals are interned by the compiler and everything built at runtime by the heap.
+	class StringObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::String;
+		static constexpr std::size_t MaxLength = std::numeric_limits<uint32_t>::max() - 64;
+
+	  public:
+		/// @brief Bytes a string of length characters takes, the terminating NUL included.
+		static constexpr std::size_t AllocationSize(std::size_t length) { return sizeof(StringObject) + length + 1; }
+
+		[[nodiscard]] static uint64_t Hash(std::string_view chars);
+
+		/// @brief A string owned by a chunk instead of the heap, for literals.
+		[[nodiscard]] static OwnedString CreatePermanent(std::string_view chars);
+
+		/// @brief Constructs into memory of at least AllocationSize(chars.size()) bytes.
+		StringObject(std::string_view chars, uint64_t hash, bool permanent = false);
+		~StringObject() = default;
+
+		[[nodiscard]] const char* GetChars() const { return reinterpret_cast<const char*>(this + 1); }
+		[[nodiscard]] std::string_view GetView() const { return {GetChars(), m_Length}; }
+		[[nodiscard]] uint32_t GetLength() const { return m_Length; }
+		[[nodiscard]] uint64_t GetHash() const { return m_Hash; }
+
+	  private:
+		uint64_t m_Hash;
+		uint32_t m_Length;
+	};
+} // namespace Glyph
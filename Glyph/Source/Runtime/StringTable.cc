@@ -0,0 +1,22 @@
+#include <Runtime/StringTable.hh>
+
+namespace Glyph
+{
+	StringObject* StringTable::Find(std::string_view chars, uint64_t hash) const
+	{
+		auto it = m_Strings.find(Key {chars, hash});
+
+		return it != m_Strings.end() ? *it : nullptr;
+	}
+
+	void StringTable::Add(StringObject* string) { m_Strings.insert(string); }
+
+	void StringTable::Remove(const StringObject* string)
+	{
+		auto it = m_Strings.find(Key {string->GetView(), string->GetHash()});
+		if(it != m_Strings.end() && *it == string)
+		{
+			m_Strings.erase(it);
+		}
+	}
+} // namespace Glyph
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Runtime/StringObject.hh>
+
+#include <absl/container/flat_hash_set.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Glyph
+{
+	/// @brief Interning table, at most one string per sequence of characters. It does not own the strings, whoever
+	/// frees one removes it first.
+	class StringTable
+	{
+	  public:
+		/// @brief The string with these characters, nullptr when there is none. hash is StringObject::Hash(chars).
+		[[nodiscard]] StringObject* Find(std::string_view chars, uint64_t hash) const;
+
+		void Add(StringObject* string);
+		/// @brief Removes the string if it is the one interned for its characters.
+		void Remove(const StringObject* string);
+		void Clear() { m_Strings.clear(); }
+
+		[[nodiscard]] std::size_t GetSize() const { return m_Strings.size(); }
+
+	  private:
+		struct Key
+		{
+			std::string_view Chars;
+			uint64_t Hash;
+		};
+
+		// Transparent so lookups by characters don't need a string object, the hash is never computed twice.
+		struct KeyHash
+		{
+			using is_transparent = void;
+
+			std::size_t operator()(const StringObject* string) const { return string->GetHash(); }
+			std::size_t operator()(const Key& key) const { return key.Hash; }
+		};
+
+		struct KeyEqual
+		{
+			using is_transparent = void;
+
+			bool operator()(const StringObject* lhs, const StringObject* rhs) const { return lhs == rhs; }
+			bool operator()(const StringObject* lhs, const Key& rhs) const { return lhs->GetView() == rhs.Chars; }
+			bool operator()(const Key& lhs, const StringObject* rhs) const { return lhs.Chars == rhs->GetView(); }
+		};
+
+	  private:
+		absl::flat_hash_set<StringObject*, KeyHash, KeyEqual> m_Strings;
+	};
+} // namespace Glyph
@@ -0,0 +1,16 @@
+#include <Runtime/UpvalueObject.hh>
+
+namespace Glyph
+{
+	UpvalueObject::UpvalueObject(Value* slot)
+		: Object(ObjectType::Upvalue)
+		, m_Location(slot)
+	{
+	}
+
+	void UpvalueObject::Close()
+	{
+		m_Closed = *m_Location;
+		m_Location = &m_Closed;
+	}
+} // namespace Glyph
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Runtime/Object.hh>
+#include <Runtime/Value.hh>
+
+namespace Glyph
+{
+	/// @brief A variable captured by a closure. While the declaring frame runs the upvalue is open and points at the
+	/// local's stack slot, when the slot goes away the value moves into the upvalue itself and it is closed.
+	class UpvalueObject : public Object
+	{
+	  public:
+		static constexpr ObjectType Type = ObjectType::Upvalue;
+
+	  public:
+		explicit UpvalueObject(Value* slot);
+		~UpvalueObject() = default;
+
+		[[nodiscard]] Value* GetLocation() const { return m_Location; }
+		[[nodiscard]] bool IsOpen() const { return m_Location != &m_Closed; }
+
+		/// @brief Copies the captured value off the stack, reads and writes go to the upvalue from now on.
+		void Close();
+
+		/// @brief Next open upvalue of the VM, ordered by descending stack slot.
+		[[nodiscard]] UpvalueObject* GetNextOpen() const { return m_NextOpen; }
+		void SetNextOpen(UpvalueObject* next) { m_NextOpen = next; }
+
+	  private:
+		Value* m_Location;
+		Value m_Closed;
+		UpvalueObject* m_NextOpen {nullptr};
+	};
+} // namespace Glyph
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <bit>
+#include <cstdint>
 #include <string>
 
 namespace Glyph
 {
-	typedef void Object; // FIXME: Use a proper object representation
+	class Object;
 
+	/// @brief A dynamically typed Glyph value.
+	/// Built with GLYPH_NAN_BOXING (meson option 'nan_boxing') every value is a single 64-bit word: numbers are stored
+	/// as plain doubles and everything else lives in the payload of a quiet NaN. Otherwise it is a tagged union.
 	class Value
 	{
 	  public:
@@ -18,28 +23,52 @@ namespace Glyph
 		};
 
 	  public:
-		Value() = delete; // FIXME: Null?
+		Value();
 		explicit Value(double value);
 		explicit Value(bool value);
-		~Value();
+		explicit Value(Object* object);
+		~Value() = default;
 
 		Value(const Value& value) = default;
-		Value& operator=(const Value& value);
+		Value& operator=(const Value& value) = default;
 		bool operator==(const Value& value) const;
 
-		[[nodiscard]] Type Type() const { return m_Type; }
-		[[nodiscard]] bool IsBool() const { return m_Type == Type::Bool; }
-		[[nodiscard]] bool IsNumber() const { return m_Type == Type::Number; }
-		[[nodiscard]] bool IsNull() const { return m_Type == Type::Null; }
-		[[nodiscard]] bool IsObject() const { return m_Type == Type::Object; }
+		[[nodiscard]] Type Type() const;
+		[[nodiscard]] bool IsBool() const;
+		[[nodiscard]] bool IsNumber() const;
+		[[nodiscard]] bool IsNull() const;
+		[[nodiscard]] bool IsObject() const;
+		/// @brief Only null and false are falsy, every other value (0 included) counts as true in a condition.
+		[[nodiscard]] bool IsTruthy() const;
 
 		[[nodiscard]] bool AsBool() const;
 		[[nodiscard]] double AsNumber() const;
 		[[nodiscard]] Object* AsObject() const;
 
+		/// @brief Raw representation of the payload. Two values of the same type with the same bits are
+		/// indistinguishable, unlike operator== this tells -0.0 from 0.0 and sees a NaN as equal to itself.
+		[[nodiscard]] uint64_t GetBits() const;
+
 		std::string ToString() const;
 
 	  private:
+#if defined(GLYPH_NAN_BOXING)
+		// Any double with all exponent bits, the quiet bit and the bit below it set is ours. Real NaNs are
+		// canonicalized on construction so they never collide with a boxed value.
+		static constexpr uint64_t SignBit = 0x8000000000000000;
+		static constexpr uint64_t QuietNaN = 0x7ffc000000000000;
+		static constexpr uint64_t CanonicalNaN = 0x7ff8000000000000;
+
+		static constexpr uint64_t TagNull = 1;
+		static constexpr uint64_t TagFalse = 2;
+		static constexpr uint64_t TagTrue = 3;
+
+		static constexpr uint64_t NullBits = QuietNaN | TagNull;
+		static constexpr uint64_t FalseBits = QuietNaN | TagFalse;
+		static constexpr uint64_t TrueBits = QuietNaN | TagTrue;
+
+		uint64_t m_Bits;
+#else
 		union as
 		{
 			explicit as(bool value)
@@ -61,5 +90,145 @@ namespace Glyph
 		} m_As;
 
 		enum Type m_Type;
+#endif
 	};
+
+#if defined(GLYPH_NAN_BOXING)
+	static_assert(sizeof(Value) == sizeof(uint64_t));
+
+	inline Value::Value()
+		: m_Bits(NullBits)
+	{
+	}
+
+	inline Value::Value(double value)
+		: m_Bits(value != value ? CanonicalNaN : std::bit_cast<uint64_t>(value))
+	{
+	}
+
+	inline Value::Value(bool value)
+		: m_Bits(value ? TrueBits : FalseBits)
+	{
+	}
+
+	// Pointers only use the low 48 bits on the platforms we care about.
+	inline Value::Value(Object* object)
+		: m_Bits(SignBit | QuietNaN | reinterpret_cast<uintptr_t>(object))
+	{
+	}
+
+	inline bool Value::IsBool() const { return (m_Bits | 1) == TrueBits; }
+	inline bool Value::IsNumber() const { return (m_Bits & QuietNaN) != QuietNaN; }
+	inline bool Value::IsNull() const { return m_Bits == NullBits; }
+	inline bool Value::IsTruthy() const { return m_Bits != NullBits && m_Bits != FalseBits; }
+	inline bool Value::IsObject() const { return (m_Bits & (SignBit | QuietNaN)) == (SignBit | QuietNaN); }
+
+	inline enum Value::Type Value::Type() const
+	{
+		if(IsNumber())
+			return Type::Number;
+		if(IsBool())
+			return Type::Bool;
+		if(IsObject())
+			return Type::Object;
+
+		return Type::Null;
+	}
+
+	inline bool Value::AsBool() const
+	{
+		if(IsNumber())
+			return std::bit_cast<double>(m_Bits) != 0;
+
+		return m_Bits == TrueBits;
+	}
+
+	inline double Value::AsNumber() const
+	{
+		if(IsNumber()) [[likely]]
+			return std::bit_cast<double>(m_Bits);
+
+		return m_Bits == TrueBits ? 1 : 0;
+	}
+
+	inline Object* Value::AsObject() const
+	{
+		if(!IsObject())
+			return nullptr;
+
+		return reinterpret_cast<Object*>(m_Bits & ~(SignBit | QuietNaN));
+	}
+
+	inline uint64_t Value::GetBits() const { return m_Bits; }
+#else
+	inline Value::Value()
+		: m_As(false)
+		, m_Type(Type::Null)
+	{
+	}
+
+	inline Value::Value(double value)
+		: m_As(value)
+		, m_Type(Type::Number)
+	{
+	}
+
+	inline Value::Value(bool value)
+		: m_As(value)
+		, m_Type(Type::Bool)
+	{
+	}
+
+	inline Value::Value(Object* object)
+		: m_As(object)
+		, m_Type(Type::Object)
+	{
+	}
+
+	inline enum Value::Type Value::Type() const { return m_Type; }
+	inline bool Value::IsBool() const { return m_Type == Type::Bool; }
+	inline bool Value::IsNumber() const { return m_Type == Type::Number; }
+	inline bool Value::IsNull() const { return m_Type == Type::Null; }
+	inline bool Value::IsTruthy() const { return !IsNull() && !(IsBool() && !AsBool()); }
+	inline bool Value::IsObject() const { return m_Type == Type::Object; }
+
+	inline bool Value::AsBool() const
+	{
+		switch(m_Type)
+		{
+			case Type::Bool: return m_As.m_BoolRep;
+			case Type::Number: return m_As.m_NumberRep != 0;
+			default: return false;
+		}
+	}
+
+	inline double Value::AsNumber() const
+	{
+		switch(m_Type)
+		{
+			case Type::Bool: return m_As.m_BoolRep ? 1 : 0;
+			case Type::Number: return m_As.m_NumberRep;
+			default: return 0;
+		}
+	}
+
+	inline Object* Value::AsObject() const
+	{
+		if(m_Type != Type::Object)
+			return nullptr;
+
+		return m_As.m_ObjRep;
+	}
+
+	inline uint64_t Value::GetBits() const
+	{
+		switch(m_Type)
+		{
+			case Type::Bool: return m_As.m_BoolRep;
+			case Type::Number: return std::bit_cast<uint64_t>(m_As.m_NumberRep);
+			case Type::Object: return reinterpret_cast<uintptr_t>(m_As.m_ObjRep);
+			default: return 0;
+		}
+	}
+#endif
 } // namespace Glyph
@@ -0,0 +1,371 @@
+#include <Runtime/VectorKernels.hh>
+
+#include <cmath>
+#include <limits>
+
+// The SIMD kernels are compiled for their instruction set with target attributes and only called once the CPU
+// reported it, the rest of the program keeps the baseline the build was configured for.
+#if !defined(GLYPH_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__))                                         \
+	&& (defined(__GNUC__) || defined(__clang__))
+#	define GLYPH_SIMD_X86 1
+#	include <immintrin.h>
+#else
+#	define GLYPH_SIMD_X86 0
+#endif
+
+namespace
+{
+	using Glyph::VectorKernels;
+
+	constexpr std::size_t Lanes = 8;
+	constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+	double Plus(double acc, double x) { return acc + x; }
+
+	// Same operand order as minpd and maxpd, which return their second operand unless the first one wins.
+	double Smaller(double acc, double x) { return acc < x ? acc : x; }
+	double Larger(double acc, double x) { return acc > x ? acc : x; }
+
+	template<double (*Op)(double, double)> double CombineLanes(const double* lanes)
+	{
+		auto low = Op(Op(lanes[0], lanes[4]), Op(lanes[1], lanes[5]));
+		auto high = Op(Op(lanes[2], lanes[6]), Op(lanes[3], lanes[7]));
+
+		return Op(low, high);
+	}
+
+	// Every set folds the elements past its last full group of eight and combines the lanes with the same scalar code,
+	// begin is always a multiple of Lanes.
+	double FinishSum(double* lanes, const double* a, std::size_t begin, std::size_t n)
+	{
+		for(std::size_t i = begin; i < n; i++)
+		{
+			lanes[i % Lanes] += a[i];
+		}
+
+		return CombineLanes<Plus>(lanes);
+	}
+
+	double FinishDot(double* lanes, const double* a, const double* b, std::size_t begin, std::size_t n)
+	{
+		for(std::size_t i = begin; i < n; i++)
+		{
+			lanes[i % Lanes] += a[i] * b[i];
+		}
+
+		return CombineLanes<Plus>(lanes);
+	}
+
+	template<double (*Op)(double, double)>
+	double FinishExtremum(double* lanes, bool sawNaN, const double* a, std::size_t begin, std::size_t n)
+	{
+		for(std::size_t i = begin; i < n; i++)
+		{
+			sawNaN |= std::isnan(a[i]);
+			lanes[i % Lanes] = Op(lanes[i % Lanes], a[i]);
+		}
+
+		return sawNaN ? std::numeric_limits<double>::quiet_NaN() : CombineLanes<Op>(lanes);
+	}
+
+	void ScalarAdd(double* out, const double* a, const double* b, std::size_t n)
+	{
+		for(std::size_t i = 0; i < n; i++)
+		{
+			out[i] = a[i] + b[i];
+		}
+	}
+
+	void ScalarMul(double* out, const double* a, const double* b, std::size_t n)
+	{
+		for(std::size_t i = 0; i < n; i++)
+		{
+			out[i] = a[i] * b[i];
+		}
+	}
+
+	void ScalarFma(double* out, const double* a, const double* b, const double* c, std::size_t n)
+	{
+		for(std::size_t i = 0; i < n; i++)
+		{
+			out[i] = std::fma(a[i], b[i], c[i]);
+		}
+	}
+
+	double ScalarSum(const double* a, std::size_t n)
+	{
+		double lanes[Lanes] = {};
+
+		return FinishSum(lanes, a, 0, n);
+	}
+
+	double ScalarMin(const double* a, std::size_t n)
+	{
+		double lanes[Lanes] = {Infinity, Infinity, Infinity, Infinity, Infinity, Infinity, Infinity, Infinity};
+
+		return FinishExtremum<Smaller>(lanes, false, a, 0, n);
+	}
+
+	double ScalarMax(const double* a, std::size_t n)
+	{
+		double lanes[Lanes] = {-Infinity, -Infinity, -Infinity, -Infinity, -Infinity, -Infinity, -Infinity, -Infinity};
+
+		return FinishExtremum<Larger>(lanes, false, a, 0, n);
+	}
+
+	double ScalarDot(const double* a, const double* b, std::size_t n)
+	{
+		double lanes[Lanes] = {};
+
+		return FinishDot(lanes, a, b, 0, n);
+	}
+
+	constexpr VectorKernels ScalarKernels {
+		"scalar", ScalarAdd, ScalarMul, ScalarFma, ScalarSum, ScalarMin, ScalarMax, ScalarDot,
+	};
+
+#if GLYPH_SIMD_X86
+#	define GLYPH_TARGET(features) __attribute__((target(features)))
+
+	// SSE2 keeps the eight lanes in four registers of two.
+
+	GLYPH_TARGET("sse2") void Sse2Add(double* out, const double* a, const double* b, std::size_t n)
+	{
+		std::size_t i = 0;
+		for(; i + 2 <= n; i += 2)
+		{
+			_mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+		}
+
+		ScalarAdd(out + i, a + i, b + i, n - i);
+	}
+
+	GLYPH_TARGET("sse2") void Sse2Mul(double* out, const double* a, const double* b, std::size_t n)
+	{
+		std::size_t i = 0;
+		for(; i + 2 <= n; i += 2)
+		{
+			_mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+		}
+
+		ScalarMul(out + i, a + i, b + i, n - i);
+	}
+
+	GLYPH_TARGET("sse2") double Sse2Sum(const double* a, std::size_t n)
+	{
+		__m128d acc[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+
+		std::size_t i = 0;
+		for(; i + Lanes <= n; i += Lanes)
+		{
+			for(std::size_t r = 0; r < 4; r++)
+			{
+				acc[r] = _mm_add_pd(acc[r], _mm_loadu_pd(a + i + 2 * r));
+			}
+		}
+
+		alignas(16) double lanes[Lanes];
+		for(std::size_t r = 0; r < 4; r++)
+		{
+			_mm_store_pd(lanes + 2 * r, acc[r]);
+		}
+
+		return FinishSum(lanes, a, i, n);
+	}
+
+	template<bool Min> GLYPH_TARGET("sse2") double Sse2Extremum(const double* a, std::size_t n)
+	{
+		auto start = _mm_set1_pd(Min ? Infinity : -Infinity);
+		__m128d acc[4] = {start, start, start, start};
+		auto nan = _mm_setzero_pd();
+
+		std::size_t i = 0;
+		for(; i + Lanes <= n; i += Lanes)
+		{
+			for(std::size_t r = 0; r < 4; r++)
+			{
+				auto x = _mm_loadu_pd(a + i + 2 * r);
+				acc[r] = Min ? _mm_min_pd(acc[r], x) : _mm_max_pd(acc[r], x);
+				nan = _mm_or_pd(nan, _mm_cmpunord_pd(x, x));
+			}
+		}
+
+		alignas(16) double lanes[Lanes];
+		for(std::size_t r = 0; r < 4; r++)
+		{
+			_mm_store_pd(lanes + 2 * r, acc[r]);
+		}
+
+		bool sawNaN = _mm_movemask_pd(nan) != 0;
+
+		return Min ? FinishExtremum<Smaller>(lanes, sawNaN, a, i, n) : FinishExtremum<Larger>(lanes, sawNaN, a, i, n);
+	}
+
+	GLYPH_TARGET("sse2") double Sse2Dot(const double* a, const double* b, std::size_t n)
+	{
+		__m128d acc[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+
+		std::size_t i = 0;
+		for(; i + Lanes <= n; i += Lanes)
+		{
+			for(std::size_t r = 0; r < 4; r++)
+			{
+				auto product = _mm_mul_pd(_mm_loadu_pd(a + i + 2 * r), _mm_loadu_pd(b + i + 2 * r));
+				acc[r] = _mm_add_pd(acc[r], product);
+			}
+		}
+
+		alignas(16) double lanes[Lanes];
+		for(std::size_t r = 0; r < 4; r++)
+		{
+			_mm_store_pd(lanes + 2 * r, acc[r]);
+		}
+
+		return FinishDot(lanes, a, b, i, n);
+	}
+
+	// No fused multiply-add outside of Fma, a fused dot product would round differently than the other sets.
+	constexpr VectorKernels Sse2Kernels {
+		"sse2", Sse2Add, Sse2Mul, ScalarFma, Sse2Sum, Sse2Extremum<true>, Sse2Extremum<false>, Sse2Dot,
+	};
+
+	// AVX2 keeps the eight lanes in two registers of four.
+
+	GLYPH_TARGET("avx2") void Avx2Add(double* out, const double* a, const double* b, std::size_t n)
+	{
+		std::size_t i = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+		}
+
+		ScalarAdd(out + i, a + i, b + i, n - i);
+	}
+
+	GLYPH_TARGET("avx2") void Avx2Mul(double* out, const double* a, const double* b, std::size_t n)
+	{
+		std::size_t i = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+		}
+
+		ScalarMul(out + i, a + i, b + i, n - i);
+	}
+
+	GLYPH_TARGET("avx2,fma")
+	void Avx2Fma(double* out, const double* a, const double* b, const double* c, std::size_t n)
+	{
+		std::size_t i = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			auto result = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _mm256_loadu_pd(c + i));
+			_mm256_storeu_pd(out + i, result);
+		}
+
+		for(; i < n; i++)
+		{
+			out[i] = std::fma(a[i], b[i], c[i]);
+		}
+	}
+
+	GLYPH_TARGET("avx2") double Avx2Sum(const double* a, std::size_t n)
+	{
+		auto low = _mm256_setzero_pd();
+		auto high = _mm256_setzero_pd();
+
+		std::size_t i = 0;
+		for(; i + Lanes <= n; i += Lanes)
+		{
+			low = _mm256_add_pd(low, _mm256_loadu_pd(a + i));
+			high = _mm256_add_pd(high, _mm256_loadu_pd(a + i + 4));
+		}
+
+		alignas(32) double lanes[Lanes];
+		_mm256_store_pd(lanes, low);
+		_mm256_store_pd(lanes + 4, high);
+
+		return FinishSum(lanes, a, i, n);
+	}
+
+	template<bool Min> GLYPH_TARGET("avx2") double Avx2Extremum(const double* a, std::size_t n)
+	{
+		auto low = _mm256_set1_pd(Min ? Infinity : -Infinity);
+		auto high = low;
+		auto nan = _mm256_setzero_pd();
+
+		std::size_t i = 0;
+		for(; i + Lanes <= n; i += Lanes)
+		{
+			auto x = _mm256_loadu_pd(a + i);
+			auto y = _mm256_loadu_pd(a + i + 4);
+			low = Min ? _mm256_min_pd(low, x) : _mm256_max_pd(low, x);
+			high = Min ? _mm256_min_pd(high, y) : _mm256_max_pd(high, y);
+			// Unordered when either lane is NaN, one compare covers both halves.
+			nan = _mm256_or_pd(nan, _mm256_cmp_pd(x, y, _CMP_UNORD_Q));
+		}
+
+		alignas(32) double lanes[Lanes];
+		_mm256_store_pd(lanes, low);
+		_mm256_store_pd(lanes + 4, high);
+
+		bool sawNaN = _mm256_movemask_pd(nan) != 0;
+
+		return Min ? FinishExtremum<Smaller>(lanes, sawNaN, a, i, n) : FinishExtremum<Larger>(lanes, sawNaN, a, i, n);
+	}
+
+	GLYPH_TARGET("avx2") double Avx2Dot(const double* a, const double* b, std::size_t n)
+	{
+		auto low = _mm256_setzero_pd();
+		auto high = _mm256_setzero_pd();
+
+		std::size_t i = 0;
+		for(; i + Lanes <= n; i += Lanes)
+		{
+			low = _mm256_add_pd(low, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			high = _mm256_add_pd(high, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+		}
+
+		alignas(32) double lanes[Lanes];
+		_mm256_store_pd(lanes, low);
+		_mm256_store_pd(lanes + 4, high);
+
+		return FinishDot(lanes, a, b, i, n);
+	}
+
+	constexpr VectorKernels Avx2Kernels {
+		"avx2", Avx2Add, Avx2Mul, Avx2Fma, Avx2Sum, Avx2Extremum<true>, Avx2Extremum<false>, Avx2Dot,
+	};
+
+#	undef GLYPH_TARGET
+#endif
+
+	const VectorKernels& SelectKernels()
+	{
+#if GLYPH_SIMD_X86
+		__builtin_cpu_init();
+
+		if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		{
+			return Avx2Kernels;
+		}
+
+		if(__builtin_cpu_supports("sse2"))
+		{
+			return Sse2Kernels;
+		}
+#endif
+
+		return ScalarKernels;
+	}
+} // namespace
+
+namespace Glyph
+{
+	const VectorKernels& GetVectorKernels()
+	{
+		static const VectorKernels& kernels = SelectKernels();
+
+		return kernels;
+	}
+} // namespace Glyph
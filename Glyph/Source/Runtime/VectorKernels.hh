@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Glyph
+{
+	/// @brief Loops over contiguous doubles, one set per instruction set. Element-wise kernels write n results to
+	/// out, which may be one of the inputs but must not overlap them otherwise.
+	///
+	/// Reductions keep eight partial results, element i going to lane i % 8, and combine the lanes in the same order
+	/// in every set: a sum is the same down to the last bit whichever CPU computed it. Min and Max are NaN as soon as
+	/// one element is, infinity on no elements.
+	struct VectorKernels
+	{
+		const char* Name;
+
+		void (*Add)(double* out, const double* a, const double* b, std::size_t n);
+		void (*Mul)(double* out, const double* a, const double* b, std::size_t n);
+		/// @brief out = a * b + c, rounded once like std::fma.
+		void (*Fma)(double* out, const double* a, const double* b, const double* c, std::size_t n);
+
+		double (*Sum)(const double* a, std::size_t n);
+		double (*Min)(const double* a, std::size_t n);
+		double (*Max)(const double* a, std::size_t n);
+		double (*Dot)(const double* a, const double* b, std::size_t n);
+	};
+
+	/// @brief The widest set the CPU supports, detected on first use. Building with GLYPH_DISABLE_SIMD leaves only
+	/// the scalar one.
+	const VectorKernels& GetVectorKernels();
+} // namespace Glyph
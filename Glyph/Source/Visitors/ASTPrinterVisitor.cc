@@ -121,9 +121,71 @@ namespace Glyph
 
 	void ASTPrinterVisitor::VisitLiteralNode(LiteralNode& node)
 	{
+		if(node.IsString())
+		{
+			out << std::string(ident, ' ') << "LiteralNode(\"" << node.GetString() << "\")" << std::endl;
+			return;
+		}
+
 		out << std::string(ident, ' ') << "LiteralNode(" << node.GetValue().ToString() << ")" << std::endl;
 	}
 
+	void ASTPrinterVisitor::VisitArrayLiteralNode(ArrayLiteralNode& node)
+	{
+		out << std::string(ident, ' ') << "ArrayLiteralNode()" << std::endl;
+		Incr();
+		for(auto& element : node.GetElements())
+		{
+			Visit(*element);
+		}
+		Decr();
+	}
+
+	void ASTPrinterVisitor::VisitDictLiteralNode(DictLiteralNode& node)
+	{
+		out << std::string(ident, ' ') << "DictLiteralNode()" << std::endl;
+		Incr();
+		for(auto& [key, value] : node.GetEntries())
+		{
+			Visit(*key);
+			Visit(*value);
+		}
+		Decr();
+	}
+
+	void ASTPrinterVisitor::VisitRecordLiteralNode(RecordLiteralNode& node)
+	{
+		out << std::string(ident, ' ') << "RecordLiteralNode()" << std::endl;
+		Incr();
+		for(auto& [name, value] : node.GetFields())
+		{
+			out << std::string(ident, ' ') << name << ":" << std::endl;
+			Visit(*value);
+		}
+		Decr();
+	}
+
+	void ASTPrinterVisitor::VisitIndexExpressionNode(IndexExpressionNode& node)
+	{
+		out << std::string(ident, ' ') << "IndexExpressionNode()" << std::endl;
+		Incr();
+		{
+			Visit(*node.GetObject());
+			Visit(*node.GetKey());
+		}
+		Decr();
+	}
+
+	void ASTPrinterVisitor::VisitFieldExpressionNode(FieldExpressionNode& node)
+	{
+		out << std::string(ident, ' ') << "FieldExpressionNode(" << node.GetName() << ")" << std::endl;
+		Incr();
+		{
+			Visit(*node.GetObject());
+		}
+		Decr();
+	}
+
 	void ASTPrinterVisitor::VisitIfExpressionNode(IfExpressionNode& node)
 	{
 		out << std::string(ident, ' ') << "IfExpressionNode()" << std::endl;